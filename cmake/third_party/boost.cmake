@@ -8,3 +8,14 @@ find_package(
         program_options
         system
 )
+
+# Saving .pt2 files with zstd compression requires Boost.Iostreams 1.70 or
+# later, built with zstd support.
+option( ENABLE_ZSTD "Enable zstd compression for .pt2 files." OFF )
+if ( ENABLE_ZSTD )
+    if ( Boost_VERSION_STRING VERSION_LESS 1.70 )
+        message( FATAL_ERROR "zstd compression requires Boost 1.70 or later." )
+    endif ()
+
+    add_definitions( -DPTE_ENABLE_ZSTD )
+endif ()
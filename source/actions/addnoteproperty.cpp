@@ -20,24 +20,7 @@
 AddNoteProperty::AddNoteProperty(const ScoreLocation &location,
                                  Note::SimpleProperty property,
                                  const QString &description)
-    : QUndoCommand(QObject::tr("Set ") + description),
-      myLocation(location),
-      myProperty(property)
+    : EditSimpleNoteProperty(location, property, true,
+                             QObject::tr("Set ") + description)
 {
-    for (const Note *note : myLocation.getSelectedNotes())
-        myOriginalNotes.push_back(*note);
-}
-
-void AddNoteProperty::redo()
-{
-    for (Note *note : myLocation.getSelectedNotes())
-        note->setProperty(myProperty, true);
-}
-
-void AddNoteProperty::undo()
-{
-    std::vector<Note *> selectedNotes = myLocation.getSelectedNotes();
-
-    for (size_t i = 0; i < myOriginalNotes.size(); ++i)
-        *selectedNotes[i] = myOriginalNotes[i];
 }
@@ -18,27 +18,15 @@
 #ifndef ACTIONS_ADDNOTEPROPERTY_H
 #define ACTIONS_ADDNOTEPROPERTY_H
 
-#include <QUndoCommand>
-#include <score/note.h>
-#include <score/scorelocation.h>
+#include "editsimplenoteproperty.h"
 
 /// Sets a simple note property for each of the selected notes.
-class AddNoteProperty : public QUndoCommand
+class AddNoteProperty : public EditSimpleNoteProperty
 {
 public:
     AddNoteProperty(const ScoreLocation &location,
                     Note::SimpleProperty property,
                     const QString &description);
-
-    virtual void redo() override;
-    virtual void undo() override;
-
-private:
-    ScoreLocation myLocation;
-    const Note::SimpleProperty myProperty;
-    /// Since setting a property may clear other properties, we need to save
-    /// a copy of the original notes.
-    std::vector<Note> myOriginalNotes;
 };
 
 #endif
@@ -17,6 +17,9 @@
   
 #include "editnoteduration.h"
 
+#include <algorithm>
+#include "undocommandid.h"
+
 EditNoteDuration::EditNoteDuration(const ScoreLocation &location,
                                    Position::DurationType duration,
                                    bool forRests)
@@ -42,3 +45,26 @@ void EditNoteDuration::undo()
     for (size_t i = 0; i < myOriginalDurations.size(); ++i)
         selectedPositions[i]->setDurationType(myOriginalDurations[i]);
 }
+
+int EditNoteDuration::id() const
+{
+    return UndoCommandId::EditNoteDuration;
+}
+
+bool EditNoteDuration::mergeWith(const QUndoCommand *other)
+{
+    auto cmd = static_cast<const EditNoteDuration *>(other);
+
+    const ScoreLocation &location = myLocation;
+    if (location.getSelectedPositions() !=
+        cmd->myLocation.getSelectedPositions())
+    {
+        return false;
+    }
+
+    myNewDuration = cmd->myNewDuration;
+    setObsolete(std::all_of(
+        myOriginalDurations.begin(), myOriginalDurations.end(),
+        [=](Position::DurationType d) { return d == myNewDuration; }));
+    return true;
+}
@@ -32,9 +32,14 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    /// Repeated edits of the same positions are combined into a single
+    /// command.
+    virtual int id() const override;
+    virtual bool mergeWith(const QUndoCommand *other) override;
+
 private:
     ScoreLocation myLocation;
-    const Position::DurationType myNewDuration;
+    Position::DurationType myNewDuration;
     std::vector<Position::DurationType> myOriginalDurations;
 };
 
@@ -0,0 +1,86 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "editsimplenoteproperty.h"
+
+#include "undocommandid.h"
+
+EditSimpleNoteProperty::EditSimpleNoteProperty(const ScoreLocation &location,
+                                               Note::SimpleProperty property,
+                                               bool enable,
+                                               const QString &text)
+    : QUndoCommand(text),
+      myLocation(location),
+      myProperty(property),
+      myEnable(enable)
+{
+    for (const Note *note : myLocation.getSelectedNotes())
+        myOriginalNotes.push_back(*note);
+}
+
+void EditSimpleNoteProperty::redo()
+{
+    std::vector<Note *> selectedNotes = myLocation.getSelectedNotes();
+
+    if (!myMergedNotes.empty())
+    {
+        for (size_t i = 0; i < myMergedNotes.size(); ++i)
+            *selectedNotes[i] = myMergedNotes[i];
+    }
+    else
+    {
+        for (Note *note : selectedNotes)
+            note->setProperty(myProperty, myEnable);
+    }
+}
+
+void EditSimpleNoteProperty::undo()
+{
+    std::vector<Note *> selectedNotes = myLocation.getSelectedNotes();
+
+    for (size_t i = 0; i < myOriginalNotes.size(); ++i)
+        *selectedNotes[i] = myOriginalNotes[i];
+}
+
+int EditSimpleNoteProperty::id() const
+{
+    return UndoCommandId::EditSimpleNoteProperty;
+}
+
+bool EditSimpleNoteProperty::mergeWith(const QUndoCommand *other)
+{
+    auto cmd = static_cast<const EditSimpleNoteProperty *>(other);
+
+    const ScoreLocation &location = myLocation;
+    const std::vector<const Note *> notes = location.getSelectedNotes();
+    if (cmd->myProperty != myProperty ||
+        cmd->myLocation.getSelectedNotes() != notes)
+    {
+        return false;
+    }
+
+    // The other command has already been performed, so record the resulting
+    // notes rather than the sequence of edits.
+    myMergedNotes.clear();
+    for (const Note *note : notes)
+        myMergedNotes.push_back(*note);
+
+    setText(cmd->text());
+    setObsolete(myMergedNotes == myOriginalNotes);
+    return true;
+}
@@ -0,0 +1,56 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ACTIONS_EDITSIMPLENOTEPROPERTY_H
+#define ACTIONS_EDITSIMPLENOTEPROPERTY_H
+
+#include <QUndoCommand>
+#include <score/note.h>
+#include <score/scorelocation.h>
+#include <vector>
+
+/// Helper class for setting or clearing a simple note property for each of
+/// the selected notes. Toggling the same property of the same notes several
+/// times in a row is merged into a single command.
+class EditSimpleNoteProperty : public QUndoCommand
+{
+public:
+    virtual void redo() override;
+    virtual void undo() override;
+
+    virtual int id() const override;
+    virtual bool mergeWith(const QUndoCommand *other) override;
+
+protected:
+    EditSimpleNoteProperty(const ScoreLocation &location,
+                           Note::SimpleProperty property, bool enable,
+                           const QString &text);
+
+private:
+    ScoreLocation myLocation;
+    const Note::SimpleProperty myProperty;
+    const bool myEnable;
+    /// Since setting a property may clear other properties, we need to save
+    /// a copy of the original notes.
+    std::vector<Note> myOriginalNotes;
+    /// If other commands were merged into this one, the final state of the
+    /// notes.
+    std::vector<Note> myMergedNotes;
+};
+
+#endif
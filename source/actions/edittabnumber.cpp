@@ -17,6 +17,8 @@
   
 #include "edittabnumber.h"
 
+#include "undocommandid.h"
+
 EditTabNumber::EditTabNumber(const ScoreLocation &location, int typedNumber)
     : QUndoCommand(QObject::tr("Edit Tab Number")),
       myLocation(location),
@@ -62,3 +64,25 @@ void EditTabNumber::undo()
                                                     myTappedHarmonicOffset);
     }
 }
+
+int EditTabNumber::id() const
+{
+    return UndoCommandId::EditTabNumber;
+}
+
+bool EditTabNumber::mergeWith(const QUndoCommand *other)
+{
+    auto cmd = static_cast<const EditTabNumber *>(other);
+
+    // If the tapped harmonic was cleared by the previous edit, the offsets
+    // no longer match and the commands must be undone separately.
+    if (cmd->myLocation.getNote() != myLocation.getNote() ||
+        cmd->myTappedHarmonicOffset != myTappedHarmonicOffset)
+    {
+        return false;
+    }
+
+    myNewNumber = cmd->myNewNumber;
+    setObsolete(myNewNumber == myOriginalNumber);
+    return true;
+}
@@ -30,6 +30,10 @@ public:
     virtual void redo() override;
     virtual void undo() override;
 
+    /// Repeated edits of the same note are combined into a single command.
+    virtual int id() const override;
+    virtual bool mergeWith(const QUndoCommand *other) override;
+
 private:
     ScoreLocation myLocation;
     const int myOriginalNumber;
@@ -27,16 +27,23 @@ PolishScore::PolishScore(Score &score)
 
 void PolishScore::redo()
 {
-    for (const System &system : myScore.getSystems())
-        myOriginalSystems.push_back(system);
+    auto systems = myScore.getSystems();
+    std::vector<System> original_systems(systems.begin(), systems.end());
 
     ScoreUtils::polishScore(myScore);
+
+    // Only hold on to the systems that were actually modified.
+    for (int i = 0; i < static_cast<int>(original_systems.size()); ++i)
+    {
+        if (!(original_systems[i] == systems[i]))
+            myOriginalSystems.emplace_back(i, std::move(original_systems[i]));
+    }
 }
 
 void PolishScore::undo()
 {
-    std::copy(myOriginalSystems.begin(), myOriginalSystems.end(),
-              myScore.getSystems().begin());
+    for (const auto &[index, system] : myOriginalSystems)
+        myScore.getSystems()[index] = system;
 
     myOriginalSystems.clear();
 }
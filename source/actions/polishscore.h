@@ -20,6 +20,8 @@
 
 #include <QUndoCommand>
 #include <score/system.h>
+#include <utility>
+#include <vector>
 
 class Score;
 
@@ -33,7 +35,9 @@ public:
 
 private:
     Score &myScore;
-    std::vector<System> myOriginalSystems;
+    /// The original contents of the systems that were modified, along with
+    /// their indices.
+    std::vector<std::pair<int, System>> myOriginalSystems;
 };
 
 #endif
@@ -20,20 +20,7 @@
 RemoveNoteProperty::RemoveNoteProperty(const ScoreLocation &location,
                                        Note::SimpleProperty property,
                                        const QString &description)
-    : QUndoCommand(QObject::tr("Remove ") + description),
-      myLocation(location),
-      myProperty(property)
+    : EditSimpleNoteProperty(location, property, false,
+                             QObject::tr("Remove ") + description)
 {
 }
-
-void RemoveNoteProperty::redo()
-{
-    for (Note *note : myLocation.getSelectedNotes())
-        note->setProperty(myProperty, false);
-}
-
-void RemoveNoteProperty::undo()
-{
-    for (Note *note : myLocation.getSelectedNotes())
-        note->setProperty(myProperty, true);
-}
@@ -18,24 +18,15 @@
 #ifndef ACTIONS_REMOVENOTEPROPERTY_H
 #define ACTIONS_REMOVENOTEPROPERTY_H
 
-#include <QUndoCommand>
-#include <score/note.h>
-#include <score/scorelocation.h>
+#include "editsimplenoteproperty.h"
 
 /// Removes a simple note property for each of the selected notes.
-class RemoveNoteProperty : public QUndoCommand
+class RemoveNoteProperty : public EditSimpleNoteProperty
 {
 public:
     RemoveNoteProperty(const ScoreLocation &location,
                        Note::SimpleProperty property,
                        const QString &description);
-
-    virtual void redo() override;
-    virtual void undo() override;
-
-private:
-    ScoreLocation myLocation;
-    const Note::SimpleProperty myProperty;
 };
 
 #endif
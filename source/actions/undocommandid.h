@@ -0,0 +1,35 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ACTIONS_UNDOCOMMANDID_H
+#define ACTIONS_UNDOCOMMANDID_H
+
+/// Identifiers returned by QUndoCommand::id() for commands that can be merged
+/// with the previous command on the undo stack. Commands that are not listed
+/// here return -1 and are never merged.
+namespace UndoCommandId
+{
+    enum : int
+    {
+        EditTabNumber = 1,
+        EditNoteDuration,
+        EditSimpleNoteProperty
+    };
+}
+
+#endif
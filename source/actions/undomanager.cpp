@@ -17,14 +17,172 @@
 
 #include "undomanager.h"
 
-UndoManager::UndoManager(QObject *parent) :
-    QUndoGroup(parent)
+#include <util/tracing.h>
+
+/// Wraps a command and requests a redraw of the affected system whenever it
+/// is undone or redone.
+class UndoManager::RedrawCommand : public QUndoCommand
+{
+public:
+    RedrawCommand(UndoManager &manager, QUndoCommand *cmd, int affectedSystem)
+        : QUndoCommand(cmd->actionText()),
+          myManager(manager),
+          myCommand(cmd),
+          myAffectedSystem(affectedSystem),
+          myIsPerformed(false)
+    {
+    }
+
+    /// Indicates that the command has already been performed, so the next
+    /// call to redo() (when it is pushed onto the stack) is skipped.
+    void setPerformed()
+    {
+        myIsPerformed = true;
+    }
+
+    void redo() override
+    {
+        if (myIsPerformed)
+        {
+            myIsPerformed = false;
+            return;
+        }
+
+        Tracing::Span span("UndoManager::redo");
+        if (span.isActive())
+            span.setDetail(myCommand->actionText().toStdString());
+
+        myCommand->redo();
+        myManager.onSystemChanged(myAffectedSystem);
+    }
+
+    void undo() override
+    {
+        Tracing::Span span("UndoManager::undo");
+        if (span.isActive())
+            span.setDetail(myCommand->actionText().toStdString());
+
+        myCommand->undo();
+        myManager.onSystemChanged(myAffectedSystem);
+    }
+
+    int id() const override
+    {
+        return myCommand->id();
+    }
+
+    bool mergeWith(const QUndoCommand *other) override
+    {
+        // Commands with the same id are always wrapped, since macros are
+        // never mergeable.
+        auto cmd = static_cast<const RedrawCommand *>(other);
+        if (cmd->myAffectedSystem != myAffectedSystem ||
+            !myCommand->mergeWith(cmd->myCommand.get()))
+        {
+            return false;
+        }
+
+        setText(myCommand->actionText());
+        setObsolete(myCommand->isObsolete());
+        return true;
+    }
+
+private:
+    UndoManager &myManager;
+    std::unique_ptr<QUndoCommand> myCommand;
+    const int myAffectedSystem;
+    bool myIsPerformed;
+};
+
+/// Groups several commands into a single entry on the undo stack, and
+/// combines their redraws.
+class UndoManager::MacroCommand : public QUndoCommand
+{
+public:
+    MacroCommand(UndoManager &manager, const QString &text)
+        : QUndoCommand(text), myManager(manager), myIsOpen(true)
+    {
+    }
+
+    /// Adds a command that has already been performed, merging it with the
+    /// previous command if possible.
+    void add(std::unique_ptr<RedrawCommand> cmd)
+    {
+        if (!myCommands.empty())
+        {
+            RedrawCommand &prev = *myCommands.back();
+            if (prev.id() != -1 && prev.id() == cmd->id() &&
+                prev.mergeWith(cmd.get()))
+            {
+                if (prev.isObsolete())
+                    myCommands.pop_back();
+                return;
+            }
+        }
+
+        myCommands.push_back(std::move(cmd));
+    }
+
+    size_t size() const
+    {
+        return myCommands.size();
+    }
+
+    /// Removes the only command from the macro.
+    std::unique_ptr<RedrawCommand> takeCommand()
+    {
+        Q_ASSERT(myCommands.size() == 1);
+        std::unique_ptr<RedrawCommand> cmd = std::move(myCommands.back());
+        myCommands.clear();
+        return cmd;
+    }
+
+    void redo() override
+    {
+        // The commands were already performed when they were added to the
+        // open macro.
+        if (myIsOpen)
+        {
+            myIsOpen = false;
+            return;
+        }
+
+        myManager.beginBatch();
+        for (auto &cmd : myCommands)
+            cmd->redo();
+        myManager.endBatch();
+    }
+
+    void undo() override
+    {
+        myManager.beginBatch();
+        for (auto it = myCommands.rbegin(); it != myCommands.rend(); ++it)
+            (*it)->undo();
+        myManager.endBatch();
+    }
+
+private:
+    UndoManager &myManager;
+    std::vector<std::unique_ptr<RedrawCommand>> myCommands;
+    bool myIsOpen;
+};
+
+UndoManager::UndoManager(QObject *parent)
+    : QUndoGroup(parent),
+      myMacroDepth(0),
+      myBatchDepth(0),
+      myPendingFullRedraw(false)
+{
+}
+
+UndoManager::~UndoManager()
 {
 }
 
 void UndoManager::addNewUndoStack()
 {
     undoStacks.emplace_back(new QUndoStack);
+    myRevisions.push_back(0);
     addStack(undoStacks.back().get());
 }
 
@@ -40,76 +198,120 @@ void UndoManager::removeStack(int index)
 {
     // Stack is automatically removed from the QUndoGroup when it is deleted.
     undoStacks.erase(undoStacks.begin() + index);
-}
-
-void UndoManager::push(QUndoCommand *cmd)
-{
-    activeStack()->push(cmd);
+    myRevisions.erase(myRevisions.begin() + index);
 }
 
 void UndoManager::push(QUndoCommand *cmd, int affectedSystem)
 {
-    beginMacro(cmd->actionText());
+    auto wrapper = std::make_unique<RedrawCommand>(*this, cmd, affectedSystem);
 
-    auto onUndo = new SignalOnUndo();
-    if (affectedSystem >= 0)
+    if (myOpenMacro)
     {
-        connect(onUndo, &SignalOnUndo::triggered, [=]() {
-            onSystemChanged(affectedSystem);
-        });
+        // Perform the command immediately, as QUndoStack does for macros.
+        wrapper->redo();
+        myOpenMacro->add(std::move(wrapper));
     }
     else
-    {
-        connect(onUndo, &SignalOnUndo::triggered, this,
-                &UndoManager::fullRedrawNeeded);
-    }
+        activeStack()->push(wrapper.release());
+}
 
-    push(onUndo);
-    push(cmd);
+void UndoManager::setClean()
+{
+    activeStack()->setClean();
+}
 
-    auto onRedo = new SignalOnRedo();
-    if (affectedSystem >= 0)
-    {
-        connect(onRedo, &SignalOnRedo::triggered, [=]() {
-            onSystemChanged(affectedSystem);
-        });
-    }
-    else
-    {
-        connect(onRedo, &SignalOnRedo::triggered, this,
-                &UndoManager::fullRedrawNeeded);
-    }
+void UndoManager::setClean(int index)
+{
+    undoStacks.at(index)->setClean();
+}
 
-    push(onRedo);
-    endMacro();
+void UndoManager::resetClean()
+{
+    activeStack()->resetClean();
 }
 
-void UndoManager::setClean()
+uint64_t UndoManager::getRevision(int index) const
 {
-    activeStack()->setClean();
+    return myRevisions.at(index);
 }
 
 void UndoManager::onSystemChanged(int affectedSystem)
 {
-    emit redrawNeeded(affectedSystem);
+    // Commands are only performed on the active stack.
+    const QUndoStack *stack = activeStack();
+    for (size_t i = 0; i < undoStacks.size(); ++i)
+    {
+        if (undoStacks[i].get() == stack)
+            ++myRevisions[i];
+    }
+
+    if (myBatchDepth > 0)
+    {
+        if (affectedSystem >= 0)
+            myPendingSystems.insert(affectedSystem);
+        else
+            myPendingFullRedraw = true;
+    }
+    else if (affectedSystem >= 0)
+        emit redrawNeeded(affectedSystem);
+    else
+        emit fullRedrawNeeded();
 }
 
-void UndoManager::beginMacro(const QString &text)
+void UndoManager::beginBatch()
 {
-    activeStack()->beginMacro(text);
+    ++myBatchDepth;
 }
 
-void UndoManager::endMacro()
+void UndoManager::endBatch()
 {
-    activeStack()->endMacro();
+    Q_ASSERT(myBatchDepth > 0);
+    if (--myBatchDepth > 0)
+        return;
+
+    std::set<int> systems;
+    systems.swap(myPendingSystems);
+    const bool fullRedraw = myPendingFullRedraw;
+    myPendingFullRedraw = false;
+
+    if (fullRedraw)
+        emit fullRedrawNeeded();
+    else
+    {
+        for (int system : systems)
+            emit redrawNeeded(system);
+    }
 }
 
-void SignalOnRedo::redo()
+void UndoManager::beginMacro(const QString &text)
 {
-    emit triggered();
+    if (myMacroDepth++ == 0)
+    {
+        myOpenMacro = std::make_unique<MacroCommand>(*this, text);
+        beginBatch();
+    }
 }
 
-void SignalOnUndo::undo()
+void UndoManager::endMacro()
 {
-    emit triggered();
+    Q_ASSERT(myMacroDepth > 0);
+    if (--myMacroDepth > 0)
+        return;
+
+    // Pushing the commands does not perform them again. A macro containing a
+    // single command is pushed as that command so that it can be merged with
+    // the previous command on the stack.
+    if (myOpenMacro->size() == 1)
+    {
+        std::unique_ptr<RedrawCommand> cmd = myOpenMacro->takeCommand();
+        cmd->setPerformed();
+        activeStack()->push(cmd.release());
+        myOpenMacro.reset();
+    }
+    else if (myOpenMacro->size() > 1)
+        activeStack()->push(myOpenMacro.release());
+    else
+        myOpenMacro.reset();
+
+    endBatch();
 }
@@ -18,9 +18,11 @@
 #ifndef ACTIONS_UNDOMANAGER_H
 #define ACTIONS_UNDOMANAGER_H
 
+#include <cstdint>
 #include <memory>
 #include <QUndoGroup>
 #include <QUndoStack>
+#include <set>
 #include <vector>
 
 class QUndoCommand;
@@ -31,6 +33,7 @@ class UndoManager : public QUndoGroup
 
 public:
     explicit UndoManager(QObject *parent = nullptr);
+    ~UndoManager();
 
     void addNewUndoStack();
     void setActiveStackIndex(int index);
@@ -42,7 +45,21 @@ public:
     void push(QUndoCommand *cmd, int affectedSystem);
 
     void setClean();
-
+    /// Marks the specified stack as clean, e.g. after a background save of
+    /// a document that is no longer active has finished.
+    void setClean(int index);
+    /// Returns a counter for the specified stack, which changes whenever one
+    /// of its commands is performed, undone or redone. Unlike the stack's
+    /// index, this also changes when a command is merged into the previous
+    /// one, so it can be used to check whether the document was modified.
+    uint64_t getRevision(int index) const;
+    /// Marks the active stack as modified, e.g. for a recovered document that
+    /// has never been saved.
+    void resetClean();
+
+    /// Groups the following commands into a single undo entry. Redraws are
+    /// deferred until the outermost macro is closed, so that each affected
+    /// system is only redrawn once.
     void beginMacro(const QString &text);
     void endMacro();
 
@@ -53,34 +70,27 @@ signals:
     void redrawNeeded(int);
 
 private:
-    /// Pushes the QUndoCommand onto the active stack.
-    void push(QUndoCommand *cmd);
+    class RedrawCommand;
+    class MacroCommand;
 
+    /// Called after a command has been undone or redone.
     void onSystemChanged(int affectedSystem);
 
-    std::vector<std::unique_ptr<QUndoStack>> undoStacks;
-};
-
-class SignalOnRedo : public QObject, public QUndoCommand
-{
-    Q_OBJECT
-
-public:
-    virtual void redo() override;
-
-signals:
-    void triggered();
-};
+    /// Defers redraw signals until the matching call to endBatch().
+    void beginBatch();
+    void endBatch();
 
-class SignalOnUndo: public QObject, public QUndoCommand
-{
-    Q_OBJECT
+    std::vector<std::unique_ptr<QUndoStack>> undoStacks;
+    /// The revision of each undo stack.
+    std::vector<uint64_t> myRevisions;
 
-public:
-    virtual void undo() override;
+    /// The outermost macro that is currently open, if any.
+    std::unique_ptr<MacroCommand> myOpenMacro;
+    int myMacroDepth;
 
-signals:
-    void triggered();
+    int myBatchDepth;
+    std::set<int> myPendingSystems;
+    bool myPendingFullRedraw;
 };
 
 #endif
@@ -0,0 +1,375 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "autosavejournal.h"
+
+#include <app/paths.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <map>
+#include <QLockFile>
+#include <score/score.h>
+#include <score/serialization.h>
+#include <sstream>
+
+static const char *theJournalExtension = ".journal";
+
+namespace
+{
+/// Identifies the document that the journal belongs to.
+struct JournalHeader
+{
+    std::string myBaseFile;
+
+    template <class Archive>
+    void serialize(Archive &ar, const FileVersion /*version*/)
+    {
+        ar("base_file", myBaseFile);
+    }
+};
+
+/// The systems that were modified, along with the score-level data (players,
+/// instruments, etc), which is small enough to always be included.
+struct JournalEntry
+{
+    int myNumSystems = 0;
+    std::map<int, System> mySystems;
+    ScoreInfo myScoreInfo;
+    std::vector<Player> myPlayers;
+    std::vector<Instrument> myInstruments;
+    std::vector<ViewFilter> myViewFilters;
+    int myLineSpacing = 0;
+
+    template <class Archive>
+    void serialize(Archive &ar, const FileVersion /*version*/)
+    {
+        ar("num_systems", myNumSystems);
+        ar("systems", mySystems);
+        ar("score_info", myScoreInfo);
+        ar("players", myPlayers);
+        ar("instruments", myInstruments);
+        ar("view_filters", myViewFilters);
+        ar("line_spacing", myLineSpacing);
+    }
+
+    void apply(Score &score) const
+    {
+        while (static_cast<int>(score.getSystems().size()) > myNumSystems)
+            score.removeSystem(static_cast<int>(score.getSystems().size()) - 1);
+        while (static_cast<int>(score.getSystems().size()) < myNumSystems)
+            score.insertSystem(System());
+
+        for (auto &[index, system] : mySystems)
+            score.getSystems()[index] = system;
+
+        score.setScoreInfo(myScoreInfo);
+
+        while (!score.getPlayers().empty())
+            score.removePlayer(0);
+        for (const Player &player : myPlayers)
+            score.insertPlayer(player);
+
+        while (!score.getInstruments().empty())
+            score.removeInstrument(0);
+        for (const Instrument &instrument : myInstruments)
+            score.insertInstrument(instrument);
+
+        while (!score.getViewFilters().empty())
+            score.removeViewFilter(0);
+        for (const ViewFilter &filter : myViewFilters)
+            score.insertViewFilter(filter);
+
+        score.setLineSpacing(myLineSpacing);
+    }
+};
+
+/// Each record is stored as its size in bytes on a separate line, followed by
+/// the JSON data. This makes it easy to detect a record that was only
+/// partially written.
+template <typename T>
+void writeRecord(std::ostream &output, const std::string &name, const T &obj)
+{
+    std::ostringstream data;
+    ScoreUtils::save(data, name, obj, ScoreUtils::OutputFormat::Compact);
+
+    const std::string str = data.str();
+    output << str.size() << '\n';
+    output.write(str.data(), str.size());
+    output << '\n';
+}
+
+/// Returns false if there are no more complete records.
+template <typename T>
+bool readRecord(std::istream &input, const std::string &name, T &obj)
+{
+    std::string line;
+    if (!std::getline(input, line))
+        return false;
+
+    size_t size;
+    try
+    {
+        size = std::stoul(line);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    std::string data(size, '\0');
+    if (!input.read(&data[0], size))
+        return false;
+    input.ignore();
+
+    std::istringstream stream(data);
+    ScoreUtils::load(stream, name, obj);
+    return true;
+}
+
+QString getLockFilename(const AutosaveJournal::PathType &journal)
+{
+    return Paths::toQString(journal) + ".lock";
+}
+}
+
+AutosaveJournal::AutosaveJournal(const PathType &dir,
+                                 const std::optional<PathType> &baseFile)
+    : myAllModified(!baseFile)
+{
+    boost::filesystem::create_directories(dir);
+    myPath = dir / boost::filesystem::unique_path(
+                       std::string("%%%%-%%%%-%%%%") + theJournalExtension);
+
+    // Hold a lock on the journal while the program is running, so that other
+    // instances do not try to recover it.
+    myLock = std::make_unique<QLockFile>(getLockFilename(myPath));
+    myLock->setStaleLockTime(0);
+    if (!myLock->tryLock(0))
+        throw std::runtime_error("Could not lock the autosave journal.");
+
+    writeHeader(baseFile);
+}
+
+AutosaveJournal::~AutosaveJournal()
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::exception &)
+    {
+        // The journal is being removed anyway.
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(myPath, ec);
+}
+
+const AutosaveJournal::PathType &AutosaveJournal::getPath() const
+{
+    return myPath;
+}
+
+void AutosaveJournal::markSystemModified(int system)
+{
+    if (!myAllModified)
+        myModifiedSystems.insert(system);
+}
+
+void AutosaveJournal::markAllModified()
+{
+    myAllModified = true;
+    myModifiedSystems.clear();
+}
+
+bool AutosaveJournal::hasChanges() const
+{
+    return myAllModified || !myModifiedSystems.empty();
+}
+
+void AutosaveJournal::write(const Score &score)
+{
+    // Entries must be appended in order.
+    flush();
+
+    if (!hasChanges())
+        return;
+
+    // Only copy the modified systems, so that this is cheap regardless of the
+    // size of the score.
+    auto entry = std::make_unique<JournalEntry>();
+    const int numSystems = static_cast<int>(score.getSystems().size());
+    entry->myNumSystems = numSystems;
+
+    if (myAllModified)
+    {
+        for (int i = 0; i < numSystems; ++i)
+            entry->mySystems[i] = score.getSystems()[i];
+    }
+    else
+    {
+        for (int i : myModifiedSystems)
+        {
+            if (i < numSystems)
+                entry->mySystems[i] = score.getSystems()[i];
+        }
+    }
+
+    entry->myScoreInfo = score.getScoreInfo();
+    entry->myPlayers.assign(score.getPlayers().begin(),
+                            score.getPlayers().end());
+    entry->myInstruments.assign(score.getInstruments().begin(),
+                                score.getInstruments().end());
+    entry->myViewFilters.assign(score.getViewFilters().begin(),
+                                score.getViewFilters().end());
+    entry->myLineSpacing = score.getLineSpacing();
+
+    myAllModified = false;
+    myModifiedSystems.clear();
+
+    myPendingWrite = std::async(
+        std::launch::async, [path = myPath, entry = std::move(entry)]() {
+            boost::filesystem::ofstream file(
+                path, std::ios::out | std::ios::binary | std::ios::app);
+            writeRecord(file, "entry", *entry);
+            file.flush();
+
+            if (!file)
+                throw std::runtime_error("Error writing to " + path.string());
+        });
+}
+
+void AutosaveJournal::flush()
+{
+    if (!myPendingWrite.valid())
+        return;
+
+    try
+    {
+        myPendingWrite.get();
+    }
+    catch (const std::exception &)
+    {
+        // The entry was lost, so the next entry must contain everything.
+        myAllModified = true;
+        throw;
+    }
+}
+
+void AutosaveJournal::reset(const std::optional<PathType> &baseFile)
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::exception &)
+    {
+        // The existing entries are discarded anyway.
+    }
+
+    myAllModified = !baseFile;
+    myModifiedSystems.clear();
+    writeHeader(baseFile);
+}
+
+void AutosaveJournal::writeHeader(const std::optional<PathType> &baseFile)
+{
+    boost::filesystem::ofstream file(myPath,
+                                     std::ios::out | std::ios::binary |
+                                         std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Error opening " + myPath.string());
+
+    JournalHeader header;
+    if (baseFile)
+        header.myBaseFile = baseFile->string();
+
+    writeRecord(file, "header", header);
+}
+
+std::vector<AutosaveJournal::PathType> AutosaveJournal::findOrphanedJournals(
+    const PathType &dir)
+{
+    std::vector<PathType> journals;
+
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator it(dir, ec), end;
+         !ec && it != end; it.increment(ec))
+    {
+        const PathType &path = it->path();
+        if (path.extension() != theJournalExtension)
+            continue;
+
+        // Stale locks (i.e. from a process that is no longer running) are
+        // automatically removed. Like the owner, don't consider the lock to be
+        // stale based on its age, since the journal of a running instance
+        // would otherwise be recovered once its lock is older than the default
+        // stale lock time.
+        QLockFile lock(getLockFilename(path));
+        lock.setStaleLockTime(0);
+        if (lock.tryLock(0))
+        {
+            lock.unlock();
+            journals.push_back(path);
+        }
+    }
+
+    return journals;
+}
+
+std::optional<AutosaveJournal::PathType> AutosaveJournal::readBaseFile(
+    const PathType &journal)
+{
+    boost::filesystem::ifstream file(journal, std::ios::in | std::ios::binary);
+
+    JournalHeader header;
+    if (!readRecord(file, "header", header))
+        throw std::runtime_error("Invalid autosave journal.");
+
+    if (header.myBaseFile.empty())
+        return std::nullopt;
+    else
+        return PathType(header.myBaseFile);
+}
+
+void AutosaveJournal::replay(const PathType &journal, Score &score)
+{
+    boost::filesystem::ifstream file(journal, std::ios::in | std::ios::binary);
+
+    JournalHeader header;
+    if (!readRecord(file, "header", header))
+        throw std::runtime_error("Invalid autosave journal.");
+
+    while (true)
+    {
+        JournalEntry entry;
+
+        // A crash while writing can leave an incomplete or corrupt entry at
+        // the end of the journal.
+        try
+        {
+            if (!readRecord(file, "entry", entry))
+                break;
+        }
+        catch (const std::exception &)
+        {
+            break;
+        }
+
+        entry.apply(score);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef APP_AUTOSAVEJOURNAL_H
+#define APP_AUTOSAVEJOURNAL_H
+
+#include <boost/filesystem/path.hpp>
+#include <future>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+class QLockFile;
+class Score;
+
+/// An append-only log of the changes made to a document since it was last
+/// saved, which allows unsaved work to be recovered after a crash.
+/// Rather than rewriting the whole score, each entry only contains the systems
+/// that were modified since the previous entry, and entries are written in a
+/// background thread.
+class AutosaveJournal
+{
+public:
+    using PathType = boost::filesystem::path;
+
+    /// Creates a new journal in the given directory for a document that was
+    /// last saved to the base file (if any).
+    /// @throws std::exception
+    AutosaveJournal(const PathType &dir,
+                    const std::optional<PathType> &baseFile);
+    AutosaveJournal(const AutosaveJournal &) = delete;
+    AutosaveJournal &operator=(const AutosaveJournal &) = delete;
+    /// Waits for any pending writes, and then removes the journal file.
+    ~AutosaveJournal();
+
+    const PathType &getPath() const;
+
+    /// Records that the given system has been modified.
+    void markSystemModified(int system);
+    /// Records that the entire score has been modified (e.g. systems were
+    /// inserted or removed).
+    void markAllModified();
+    /// Returns whether there are any changes that have not been written yet.
+    bool hasChanges() const;
+
+    /// Copies the modified parts of the score, and appends them to the journal
+    /// in a background thread.
+    /// @throws std::exception if the previous write failed.
+    void write(const Score &score);
+    /// Waits for any pending writes to complete. If a write failed, the
+    /// entire score is written again on the next call to write().
+    /// @throws std::exception
+    void flush();
+    /// Discards all entries after the document was saved to the given file.
+    /// @throws std::exception
+    void reset(const std::optional<PathType> &baseFile);
+
+    /// Returns any journals in the directory that do not belong to a running
+    /// instance of the program (e.g. they were left behind by a crash).
+    static std::vector<PathType> findOrphanedJournals(const PathType &dir);
+    /// Returns the file that the journal's document was last saved to, if any.
+    /// @throws std::exception
+    static std::optional<PathType> readBaseFile(const PathType &journal);
+    /// Applies the journal's entries to a score that was loaded from the base
+    /// file (or an empty score if there isn't one). A final entry that was
+    /// only partially written is ignored.
+    /// @throws std::exception
+    static void replay(const PathType &journal, Score &score);
+
+private:
+    void writeHeader(const std::optional<PathType> &baseFile);
+
+    PathType myPath;
+    std::unique_ptr<QLockFile> myLock;
+    std::set<int> myModifiedSystems;
+    bool myAllModified;
+    std::future<void> myPendingWrite;
+};
+
+#endif
@@ -24,13 +24,16 @@
 #include <QMessageBox>
 #include <QMimeData>
 #include <QString>
+#include <memory>
+#include <score/binaryserialization.h>
 #include <score/position.h>
 #include <score/scorelocation.h>
-#include <score/serialization.h>
 #include <score/staff.h>
 #include <sstream>
 
-static const QString PTB_MIME_TYPE = "application/ptb";
+/// The selection is stored in the compact binary format, which is only meant
+/// for exchanging data between running instances.
+static const QString PTB_MIME_TYPE = "application/x-ptb-selection";
 
 class ClipboardSelection
 {
@@ -79,6 +82,49 @@ private:
     std::vector<IrregularGrouping> myGroups;
 };
 
+/// Keeps the copied selection, so that pasting within the same process can use
+/// it directly. The binary data is only produced if another application asks
+/// for it.
+class ClipboardMimeData : public QMimeData
+{
+public:
+    explicit ClipboardMimeData(std::unique_ptr<ClipboardSelection> selection)
+        : mySelection(std::move(selection))
+    {
+    }
+
+    const ClipboardSelection &getSelection() const
+    {
+        return *mySelection;
+    }
+
+    bool hasFormat(const QString &mimeType) const override
+    {
+        return mimeType == PTB_MIME_TYPE;
+    }
+
+    QStringList formats() const override
+    {
+        return { PTB_MIME_TYPE };
+    }
+
+protected:
+    QVariant retrieveData(const QString &mimeType,
+                          QVariant::Type type) const override
+    {
+        if (mimeType != PTB_MIME_TYPE)
+            return QMimeData::retrieveData(mimeType, type);
+
+        std::ostringstream ss;
+        ScoreUtils::saveBinary(ss, "clipboard_selection", *mySelection);
+        const std::string data = ss.str();
+        return QByteArray(data.data(), static_cast<int>(data.size()));
+    }
+
+private:
+    std::unique_ptr<ClipboardSelection> mySelection;
+};
+
 void Clipboard::copySelection(const ScoreLocation &location)
 {
     const auto selectedPositions = location.getSelectedPositions();
@@ -87,23 +133,13 @@ void Clipboard::copySelection(const ScoreLocation &location)
     if (selectedPositions.empty())
         return;
 
-    
-    ClipboardSelection selection(numStrings, selectedPositions,
-                                 location.getSelectedIrregularGroupings());
-
-    // Serialize the notes to a string.
-    std::ostringstream ss;
-    ScoreUtils::save(ss, "clipboard_selection", selection);
-    const std::string data = ss.str();
-
-    // Copy the data to the clipboard.
-    auto mimeData = new QMimeData();
-    mimeData->setData(
-        PTB_MIME_TYPE,
-        QByteArray(data.c_str(), static_cast<int>(data.length())));
+    auto selection = std::make_unique<ClipboardSelection>(
+        numStrings, selectedPositions,
+        location.getSelectedIrregularGroupings());
 
+    // The clipboard takes ownership of the data.
     QClipboard *clipboard = QApplication::clipboard();
-    clipboard->setMimeData(mimeData);
+    clipboard->setMimeData(new ClipboardMimeData(std::move(selection)));
 }
 
 void Clipboard::paste(QWidget *parent, UndoManager &undoManager,
@@ -111,15 +147,26 @@ void Clipboard::paste(QWidget *parent, UndoManager &undoManager,
 {
     const int currentStaffSize = location.getStaff().getStringCount();
 
-    // Load data from the clipboard and deserialize.
-    const QByteArray rawData =
-        QApplication::clipboard()->mimeData()->data(PTB_MIME_TYPE);
-    Q_ASSERT(!rawData.isEmpty());
+    // If the data was copied from this process, use it directly. Otherwise,
+    // load the data from the clipboard and deserialize.
+    const QMimeData *mimeData = QApplication::clipboard()->mimeData();
+    ClipboardSelection loadedSelection;
+    const ClipboardSelection *selectionPtr = &loadedSelection;
 
-    std::istringstream inputData(std::string(rawData.data(), rawData.length()));
+    if (auto cached = dynamic_cast<const ClipboardMimeData *>(mimeData))
+        selectionPtr = &cached->getSelection();
+    else
+    {
+        const QByteArray rawData = mimeData->data(PTB_MIME_TYPE);
+        Q_ASSERT(!rawData.isEmpty());
+
+        std::istringstream inputData(
+            std::string(rawData.data(), rawData.length()));
+        ScoreUtils::loadBinary(inputData, "clipboard_selection",
+                               loadedSelection);
+    }
 
-    ClipboardSelection selection;
-    ScoreUtils::load(inputData, "clipboard_selection", selection);
+    const ClipboardSelection &selection = *selectionPtr;
 
     // For safety, prevent pasting into a tuning with a different number of
     // strings.
@@ -138,8 +185,7 @@ void Clipboard::paste(QWidget *parent, UndoManager &undoManager,
 
 bool Clipboard::hasData()
 {
-    return !QApplication::clipboard()
-                ->mimeData()
-                ->data(PTB_MIME_TYPE)
-                .isEmpty();
+    // Avoid requesting the data itself, which may need to be serialized.
+    const QMimeData *mimeData = QApplication::clipboard()->mimeData();
+    return mimeData && mimeData->hasFormat(PTB_MIME_TYPE);
 }
@@ -0,0 +1,128 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "documentloader.h"
+
+#include <algorithm>
+#include <app/documentmanager.h>
+#include <formats/fileformatmanager.h>
+
+DocumentLoader::Request::Request(const PathType &path, const FileFormat &format)
+    : myPath(path), myFormat(format)
+{
+}
+
+DocumentLoader::DocumentLoader(const FileFormatManager &manager,
+                               std::vector<Request> requests,
+                               unsigned int numThreads)
+    : myManager(manager),
+      myRequests(std::move(requests)),
+      myNextRequest(0),
+      myNumCompleted(0),
+      myNumActiveWorkers(0),
+      myCancelled(false)
+{
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // There's no point in having more threads than files.
+    numThreads = std::min(numThreads,
+                          static_cast<unsigned int>(myRequests.size()));
+
+    myNumActiveWorkers = numThreads;
+    for (unsigned int i = 0; i < numThreads; ++i)
+        myWorkers.emplace_back(&DocumentLoader::runWorker, this);
+}
+
+DocumentLoader::~DocumentLoader()
+{
+    cancel();
+
+    for (std::thread &worker : myWorkers)
+        worker.join();
+}
+
+std::vector<DocumentLoader::Result> DocumentLoader::takeFinished()
+{
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    std::vector<Result> finished;
+    finished.swap(myFinished);
+    return finished;
+}
+
+void DocumentLoader::cancel()
+{
+    myCancelled = true;
+}
+
+bool DocumentLoader::isCancelled() const
+{
+    return myCancelled;
+}
+
+bool DocumentLoader::isFinished() const
+{
+    return myNumActiveWorkers == 0;
+}
+
+size_t DocumentLoader::getNumRequests() const
+{
+    return myRequests.size();
+}
+
+size_t DocumentLoader::getNumCompleted() const
+{
+    return myNumCompleted;
+}
+
+void DocumentLoader::runWorker()
+{
+    while (!myCancelled)
+    {
+        const size_t index = myNextRequest++;
+        if (index >= myRequests.size())
+            break;
+
+        const Request &request = myRequests[index];
+
+        Result result;
+        result.myPath = request.myPath;
+
+        try
+        {
+            auto doc = std::make_unique<Document>();
+            myManager.importFile(doc->getScore(), request.myPath,
+                                 request.myFormat);
+            doc->setFilename(request.myPath);
+            result.myDocument = std::move(doc);
+        }
+        catch (const std::exception &e)
+        {
+            result.myError = e.what();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(myMutex);
+            myFinished.push_back(std::move(result));
+        }
+
+        ++myNumCompleted;
+    }
+
+    --myNumActiveWorkers;
+}
@@ -0,0 +1,103 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef APP_DOCUMENTLOADER_H
+#define APP_DOCUMENTLOADER_H
+
+#include <atomic>
+#include <boost/filesystem/path.hpp>
+#include <formats/fileformat.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Document;
+class FileFormatManager;
+
+/// Imports a batch of files on a small pool of worker threads. Finished
+/// documents are collected with takeFinished(), in whichever order the imports
+/// complete.
+class DocumentLoader
+{
+public:
+    using PathType = boost::filesystem::path;
+
+    struct Request
+    {
+        Request(const PathType &path, const FileFormat &format);
+
+        PathType myPath;
+        FileFormat myFormat;
+    };
+
+    struct Result
+    {
+        PathType myPath;
+        /// The loaded document, or null if the import failed.
+        std::unique_ptr<Document> myDocument;
+        /// Error message if the import failed.
+        std::string myError;
+    };
+
+    /// Starts importing the files. If the number of threads is zero, one
+    /// thread per hardware core is used.
+    DocumentLoader(const FileFormatManager &manager,
+                   std::vector<Request> requests, unsigned int numThreads = 0);
+    DocumentLoader(const DocumentLoader &) = delete;
+    DocumentLoader &operator=(const DocumentLoader &) = delete;
+
+    /// Cancels any pending imports and waits for the worker threads to exit.
+    ~DocumentLoader();
+
+    /// Returns the documents that have finished loading since the last call.
+    /// This does not block.
+    std::vector<Result> takeFinished();
+
+    /// Prevents any imports that have not yet started from running. Imports
+    /// that are already in progress will still complete.
+    void cancel();
+
+    /// Returns whether cancel() has been called.
+    bool isCancelled() const;
+
+    /// Returns whether all imports have either completed or been cancelled.
+    bool isFinished() const;
+
+    /// Returns the total number of files that were requested.
+    size_t getNumRequests() const;
+    /// Returns the number of imports that have completed.
+    size_t getNumCompleted() const;
+
+private:
+    void runWorker();
+
+    const FileFormatManager &myManager;
+    const std::vector<Request> myRequests;
+
+    std::atomic<size_t> myNextRequest;
+    std::atomic<size_t> myNumCompleted;
+    std::atomic<unsigned int> myNumActiveWorkers;
+    std::atomic<bool> myCancelled;
+
+    mutable std::mutex myMutex;
+    std::vector<Result> myFinished;
+    std::vector<std::thread> myWorkers;
+};
+
+#endif
@@ -19,6 +19,12 @@
 
 #include <app/settings.h>
 #include <app/settingsmanager.h>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <cassert>
+#include <score/serialization.h>
 
 DocumentManager::DocumentManager()
 {
@@ -26,7 +32,12 @@ DocumentManager::DocumentManager()
 
 Document &DocumentManager::addDocument()
 {
-    myDocumentList.emplace_back(new Document());
+    return addDocument(std::make_unique<Document>());
+}
+
+Document &DocumentManager::addDocument(std::unique_ptr<Document> doc)
+{
+    myDocumentList.push_back(std::move(doc));
     myCurrentIndex = static_cast<int>(myDocumentList.size()) - 1;
     return *myDocumentList.back();
 }
@@ -137,7 +148,8 @@ int DocumentManager::findDocument(const Document::PathType &filepath)
 }
 
 Document::Document()
-    : myCaret(myScore, myViewOptions)
+    : myScore(&myScoreMemory),
+      myCaret(myScore, myViewOptions)
 {
 }
 
@@ -158,21 +170,85 @@ void Document::setFilename(const PathType &filename)
 
 const Score &Document::getScore() const
 {
+    if (isScoreCompressed())
+        throw std::logic_error("The score must be decompressed first");
+
     return myScore;
 }
 
 Score &Document::getScore()
 {
+    ensureDecompressed();
     return myScore;
 }
 
+void Document::compressScore()
+{
+    if (isScoreCompressed())
+        return;
+
+    std::string buffer;
+    {
+        namespace io = boost::iostreams;
+        io::filtering_ostream output;
+        output.push(io::gzip_compressor(io::gzip_params(io::zlib::best_speed)));
+        output.push(io::back_inserter(buffer));
+        ScoreUtils::save(output, "score", myScore,
+                         ScoreUtils::OutputFormat::Compact);
+    }
+
+    myCompressedScore = std::move(buffer);
+
+    // Release the score's data. The object itself must stay alive, since the
+    // caret and the undo history refer to it.
+    myScore.clearSystems();
+    myScoreMemory.release();
+    while (!myScore.getPlayers().empty())
+        myScore.removePlayer(static_cast<int>(myScore.getPlayers().size()) - 1);
+    while (!myScore.getInstruments().empty())
+    {
+        myScore.removeInstrument(
+            static_cast<int>(myScore.getInstruments().size()) - 1);
+    }
+    while (!myScore.getViewFilters().empty())
+    {
+        myScore.removeViewFilter(
+            static_cast<int>(myScore.getViewFilters().size()) - 1);
+    }
+}
+
+bool Document::isScoreCompressed() const
+{
+    return !myCompressedScore.empty();
+}
+
+void Document::ensureDecompressed()
+{
+    if (isScoreCompressed())
+        decompressScore();
+}
+
+void Document::decompressScore()
+{
+    namespace io = boost::iostreams;
+    io::filtering_istream input;
+    input.push(io::gzip_decompressor());
+    input.push(io::array_source(myCompressedScore.data(),
+                                myCompressedScore.size()));
+
+    ScoreUtils::load(input, "score", myScore);
+    myCompressedScore.clear();
+    myCompressedScore.shrink_to_fit();
+}
+
 void Document::validateViewOptions()
 {
-    if (myScore.getViewFilters().empty())
+    const Score &score = getScore();
+    if (score.getViewFilters().empty())
         myViewOptions.clearFilter();
     else if (myViewOptions.getFilter() &&
              *myViewOptions.getFilter() >=
-                 static_cast<int>(myScore.getViewFilters().size()))
+                 static_cast<int>(score.getViewFilters().size()))
     {
         myViewOptions.setFilter(0);
     }
@@ -187,3 +263,17 @@ Caret &Document::getCaret()
 {
     return myCaret;
 }
+
+const PerformanceMap &Document::getPerformanceMap()
+{
+    myPerformanceMap.update(getScore());
+    return myPerformanceMap;
+}
+
+void Document::markSystemModified(std::optional<int> system)
+{
+    if (system)
+        myPerformanceMap.markSystemModified(*system);
+    else
+        myPerformanceMap.markAllModified();
+}
@@ -21,9 +21,12 @@
 #include <app/viewoptions.h>
 #include <app/caret.h>
 #include <boost/filesystem/path.hpp>
+#include <midi/performancemap.h>
 #include <optional>
 #include <memory>
+#include <memory_resource>
 #include <score/score.h>
+#include <string>
 #include <vector>
 
 class SettingsManager;
@@ -42,9 +45,20 @@ public:
     const PathType &getFilename() const;
     void setFilename(const PathType &filename);
 
+    /// Returns the score. Throws std::logic_error if the score is compressed,
+    /// so that reading it never modifies the document.
     const Score &getScore() const;
+    /// Returns the score, decompressing it first if necessary.
     Score &getScore();
 
+    /// Serializes the score into a compressed in-memory buffer while the
+    /// document is inactive, to reduce memory usage. The score must be
+    /// restored with ensureDecompressed() before it is read again.
+    void compressScore();
+    bool isScoreCompressed() const;
+    /// Restores the score if it was compressed.
+    void ensureDecompressed();
+
     const ViewOptions &getViewOptions() const { return myViewOptions; }
     ViewOptions &getViewOptions() { return myViewOptions; }
 
@@ -54,11 +68,25 @@ public:
     const Caret &getCaret() const;
     Caret &getCaret();
 
+    /// Returns the playback timing of the score, which is first updated if
+    /// any systems were modified.
+    const PerformanceMap &getPerformanceMap();
+    /// Marks a system as modified, or all systems if no index is given.
+    void markSystemModified(std::optional<int> system = std::nullopt);
+
 private:
+    void decompressScore();
+
     std::optional<PathType> myFilename;
+    /// Holds the score's systems, staves, positions, etc. so that they are
+    /// released in bulk when the document is closed.
+    std::pmr::unsynchronized_pool_resource myScoreMemory;
     Score myScore;
+    /// The gzip-compressed score, if the score has been compressed.
+    std::string myCompressedScore;
     ViewOptions myViewOptions;
     Caret myCaret;
+    PerformanceMap myPerformanceMap;
 };
 
 /// Class for managing open documents.
@@ -69,6 +97,9 @@ public:
 
     /// Add a new, blank document.
     Document &addDocument();
+    /// Add a document that was created elsewhere (e.g. loaded in a background
+    /// thread).
+    Document &addDocument(std::unique_ptr<Document> doc);
     /// Add a new document, and initialize it with a staff, player, etc.
     Document &addDefaultDocument(const SettingsManager &settings_manager);
 
@@ -73,9 +73,11 @@
 #include <actions/undomanager.h>
 
 #include <app/appinfo.h>
+#include <app/autosavejournal.h>
 #include <app/caret.h>
 #include <app/clipboard.h>
 #include <app/command.h>
+#include <app/documentloader.h>
 #include <app/documentmanager.h>
 #include <app/paths.h>
 #include <app/pubsub/clickpubsub.h>
@@ -85,9 +87,12 @@
 #include <app/settingsmanager.h>
 #include <app/tuningdictionary.h>
 
+#include <audio/midioutputservice.h>
 #include <audio/midiplayer.h>
 #include <audio/settings.h>
 
+#include <algorithm>
+#include <boost/filesystem/operations.hpp>
 #include <boost/range/algorithm/transform.hpp>
 #include <chrono>
 
@@ -134,8 +139,10 @@
 #include <QPrinter>
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
+#include <QProgressDialog>
 #include <QScrollArea>
 #include <QTabBar>
+#include <QTimer>
 #include <QUrl>
 #include <QVBoxLayout>
 
@@ -143,18 +150,44 @@
 #include <score/voiceutils.h>
 
 #include <util/tostring.h>
+#include <util/tracing.h>
 
 #include <widgets/instruments/instrumentpanel.h>
 #include <widgets/mixer/mixer.h>
 #include <widgets/playback/playbackwidget.h>
 
+/// Returns the directory where autosave journals are stored.
+static Paths::path getAutosaveDir()
+{
+    return Paths::getUserDataDir() / "autosave";
+}
+
+/// Returns the bars to loop, which are the bars containing the selection or the
+/// caret.
+static MidiPlayer::LoopRegion getLoopRegion(const ScoreLocation &location)
+{
+    const int start =
+        std::min(location.getSelectionStart(), location.getPositionIndex());
+    const int end =
+        std::max(location.getSelectionStart(), location.getPositionIndex());
+
+    return { SystemLocation(location.getSystemIndex(), start),
+             SystemLocation(location.getSystemIndex(), end) };
+}
+
 PowerTabEditor::PowerTabEditor()
     : QMainWindow(nullptr),
       mySettingsManager(new SettingsManager()),
       myDocumentManager(new DocumentManager()),
       myFileFormatManager(new FileFormatManager(*mySettingsManager)),
       myUndoManager(new UndoManager()),
+      myMidiOutputService(new MidiOutputService(*mySettingsManager)),
       myTuningDictionary(new TuningDictionary()),
+      myLoadProgressDialog(nullptr),
+      myLoadTimer(nullptr),
+      mySaveTimer(nullptr),
+      myAutosaveTimer(nullptr),
+      myHibernateTimer(nullptr),
       myIsPlaying(false),
       myRecentFiles(nullptr),
       myActiveDurationType(Position::EighthNote),
@@ -164,8 +197,14 @@ PowerTabEditor::PowerTabEditor()
       myInstrumentPanel(nullptr),
       myInstrumentDockWidget(nullptr),
       myPlaybackWidget(nullptr),
-      myPlaybackArea(nullptr)
+      myPlaybackArea(nullptr),
+      myIsPainted(false),
+      myHasAutosaveError(false),
+      myRecoverOnStartup(true),
+      myIsLoadingStartupFiles(false)
 {
+    Tracing::Span span("PowerTabEditor::PowerTabEditor");
+
     this->setWindowIcon(QIcon(":icons/app_icon.png"));
 
     setAcceptDrops(true);
@@ -183,9 +222,43 @@ PowerTabEditor::PowerTabEditor()
     connect(myUndoManager.get(), &UndoManager::cleanChanged, this,
             &PowerTabEditor::updateModified);
 
+    // Keep track of the modified systems for the autosave journal.
+    connect(myUndoManager.get(), &UndoManager::redrawNeeded, this,
+            [=](int system) {
+                if (AutosaveJournal *journal = getAutosaveJournal())
+                    journal->markSystemModified(system);
+            });
+    connect(myUndoManager.get(), &UndoManager::fullRedrawNeeded, this, [=]() {
+        if (AutosaveJournal *journal = getAutosaveJournal())
+            journal->markAllModified();
+    });
+
+    // Keep track of the modified systems for the playback timing.
+    connect(myUndoManager.get(), &UndoManager::redrawNeeded, this,
+            [=](int system) {
+                myDocumentManager->getCurrentDocument().markSystemModified(
+                    system);
+            });
+    connect(myUndoManager.get(), &UndoManager::fullRedrawNeeded, this, [=]() {
+        myDocumentManager->getCurrentDocument().markSystemModified();
+    });
+
+    mySaveTimer = new QTimer(this);
+    connect(mySaveTimer, &QTimer::timeout, this, [=]() {
+        if (myPendingSave && myPendingSave->myResult.wait_for(
+                                 std::chrono::seconds(0)) ==
+                                 std::future_status::ready)
+        {
+            finishPendingSave();
+        }
+    });
+
     myTuningDictionary->loadInBackground();
     mySettingsManager->load(Paths::getConfigDir());
 
+    // Open the MIDI port ahead of time, since this can be slow.
+    myMidiOutputService->openInBackground();
+
     createMixer();
     createInstrumentPanel();
     createCommands();
@@ -207,6 +280,19 @@ PowerTabEditor::PowerTabEditor()
     // Restore the state of any dock widgets.
     restoreState(settings->get(Settings::WindowState));
 
+    myAutosaveTimer = new QTimer(this);
+    connect(myAutosaveTimer, &QTimer::timeout, this, &PowerTabEditor::autosave);
+    const int autosaveInterval = settings->get(Settings::AutosaveInterval);
+    if (autosaveInterval > 0)
+        myAutosaveTimer->start(autosaveInterval * 1000);
+
+    myHibernateTimer = new QTimer(this);
+    connect(myHibernateTimer, &QTimer::timeout, this,
+            &PowerTabEditor::hibernateInactiveTabs);
+    const int hibernateTimeout = settings->get(Settings::TabHibernateTimeout);
+    if (hibernateTimeout > 0)
+        myHibernateTimer->start(std::max(hibernateTimeout / 2, 1) * 1000);
+
     setCentralWidget(myPlaybackArea);
     setMinimumSize(800, 600);
     setWindowState(Qt::WindowMaximized);
@@ -217,10 +303,207 @@ PowerTabEditor::~PowerTabEditor()
 {
 }
 
+void PowerTabEditor::finishStartup(const QStringList &files,
+                                   bool recoverDocuments)
+{
+    myStartupFiles = files;
+    myRecoverOnStartup = recoverDocuments;
+
+    // Don't rely on the window being painted, since e.g. a minimized window
+    // might not be.
+    QTimer::singleShot(0, this, &PowerTabEditor::runDeferredStartup);
+}
+
+void PowerTabEditor::runDeferredStartup()
+{
+    if (!myStartupFiles)
+        return;
+
+    Tracing::Span span("PowerTabEditor::runDeferredStartup");
+
+    // If the window hasn't been drawn yet, do so before opening any files.
+    if (!myIsPainted)
+        repaint();
+
+    const QStringList files = std::move(*myStartupFiles);
+    myStartupFiles.reset();
+
+    if (myRecoverOnStartup)
+        recoverAutosavedDocuments();
+    openFiles(files);
+
+    // If several files are being opened in the background, wait until they
+    // have all been loaded.
+    if (myDocumentLoader)
+        myIsLoadingStartupFiles = true;
+    else
+        emit startupFinished();
+}
+
 void PowerTabEditor::openFiles(const QStringList &files)
 {
+    // Open a single file directly. If a batch of files is still being loaded,
+    // also just open the new files one at a time.
+    if (files.size() <= 1 || myDocumentLoader)
+    {
+        for (auto &filename : files)
+            openFile(filename);
+        return;
+    }
+
+    std::vector<DocumentLoader::Request> requests;
     for (auto &filename : files)
-        openFile(filename);
+    {
+        if (std::optional<FileFormat> format = findFormatForOpening(filename))
+            requests.emplace_back(Paths::fromQString(filename), *format);
+    }
+
+    if (requests.empty())
+        return;
+
+    const int numFiles = static_cast<int>(requests.size());
+    myDocumentLoader = std::make_unique<DocumentLoader>(*myFileFormatManager,
+                                                        std::move(requests));
+    myLoadErrors.clear();
+
+    myLoadProgressDialog = new QProgressDialog(tr("Opening files..."),
+                                               tr("Cancel"), 0, numFiles, this);
+    myLoadProgressDialog->setWindowTitle(tr("Open"));
+    myLoadProgressDialog->setMinimumDuration(500);
+    myLoadProgressDialog->setValue(0);
+    connect(myLoadProgressDialog, &QProgressDialog::canceled, this,
+            [=]() {
+                if (myDocumentLoader)
+                    myDocumentLoader->cancel();
+            });
+
+    myLoadTimer = new QTimer(this);
+    connect(myLoadTimer, &QTimer::timeout, this,
+            &PowerTabEditor::processLoadedDocuments);
+    myLoadTimer->start(50);
+}
+
+void PowerTabEditor::recoverAutosavedDocuments()
+{
+    const std::vector<Paths::path> journals =
+        AutosaveJournal::findOrphanedJournals(getAutosaveDir());
+    if (journals.empty())
+        return;
+
+    const int ret = QMessageBox::question(
+        this, tr("Recover Documents"),
+        tr("%n document(s) had unsaved changes when the program last exited. "
+           "Do you want to recover them? Otherwise, the changes will be "
+           "discarded.",
+           nullptr, static_cast<int>(journals.size())));
+
+    for (const Paths::path &journalPath : journals)
+    {
+        // If the user chose to discard the changes, just remove the journal.
+        bool remove = true;
+
+        if (ret == QMessageBox::Yes)
+        {
+            try
+            {
+                // Load the last saved version of the document, and then apply
+                // the changes from the journal.
+                auto doc = std::make_unique<Document>();
+                if (std::optional<Paths::path> baseFile =
+                        AutosaveJournal::readBaseFile(journalPath))
+                {
+                    std::optional<FileFormat> format =
+                        myFileFormatManager->findFormat(
+                            baseFile->extension().string().substr(1));
+                    if (!format)
+                        throw std::runtime_error("Unsupported file type.");
+
+                    myFileFormatManager->importFile(doc->getScore(), *baseFile,
+                                                    *format);
+                    doc->setFilename(*baseFile);
+                }
+
+                AutosaveJournal::replay(journalPath, doc->getScore());
+
+                myDocumentManager->addDocument(std::move(doc));
+                setupNewTab();
+
+                // The recovered changes still need to be saved.
+                myUndoManager->resetClean();
+                if (AutosaveJournal *journal = getAutosaveJournal())
+                    journal->markAllModified();
+            }
+            catch (const std::exception &e)
+            {
+                // Keep the journal so that the changes are not lost.
+                remove = false;
+
+                QMessageBox::warning(
+                    this, tr("Error Recovering Document"),
+                    tr("Error recovering document: %1\n\nThe unsaved changes "
+                       "have been kept in %2")
+                        .arg(QString(e.what()), Paths::toQString(journalPath)));
+            }
+        }
+
+        if (remove)
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(journalPath, ec);
+        }
+    }
+}
+
+void PowerTabEditor::processLoadedDocuments()
+{
+    Q_ASSERT(myDocumentLoader);
+
+    // Check this before collecting the results, so that nothing which finishes
+    // in between is missed.
+    const bool finished = myDocumentLoader->isFinished();
+
+    for (DocumentLoader::Result &result : myDocumentLoader->takeFinished())
+    {
+        const QString filename = Paths::toQString(result.myPath);
+
+        if (!result.myDocument)
+        {
+            myLoadErrors.append(
+                tr("%1: %2").arg(filename,
+                                 QString::fromStdString(result.myError)));
+        }
+        else if (!myDocumentLoader->isCancelled())
+            addOpenedDocument(std::move(result.myDocument), filename);
+    }
+
+    myLoadProgressDialog->setValue(
+        static_cast<int>(myDocumentLoader->getNumCompleted()));
+
+    if (!finished)
+        return;
+
+    myLoadTimer->stop();
+    myLoadTimer->deleteLater();
+    myLoadTimer = nullptr;
+
+    myLoadProgressDialog->deleteLater();
+    myLoadProgressDialog = nullptr;
+
+    myDocumentLoader.reset();
+
+    if (myIsLoadingStartupFiles)
+    {
+        myIsLoadingStartupFiles = false;
+        emit startupFinished();
+    }
+
+    if (!myLoadErrors.empty())
+    {
+        QMessageBox::warning(
+            this, tr("Error Opening File"),
+            tr("Error opening file: %1").arg(myLoadErrors.join("\n")));
+        myLoadErrors.clear();
+    }
 }
 
 void PowerTabEditor::createNewDocument()
@@ -241,73 +524,82 @@ void PowerTabEditor::openFile(QString filename)
     if (filename.isEmpty())
         return;
 
-    auto path = Paths::fromQString(filename);
-
-    int validationResult = myDocumentManager->findDocument(path);
-    if (validationResult > -1)
-    {
-        qDebug() << "File: " << filename << " is already open";
-        myTabWidget->setCurrentIndex(validationResult);
+    std::optional<FileFormat> format = findFormatForOpening(filename);
+    if (!format)
         return;
-    }
 
+    auto path = Paths::fromQString(filename);
     auto start = std::chrono::high_resolution_clock::now();
 
     qDebug() << "Opening file: " << filename;
 
-    QFileInfo fileInfo(filename);
-    std::optional<FileFormat> format = myFileFormatManager->findFormat(
-                fileInfo.suffix().toStdString());
-
-    if (!format)
-    {
-        QMessageBox::warning(this, tr("Error Opening File"),
-                             tr("Unsupported file type."));
-        return;
-    }
-
     try
     {
-        Document &doc = myDocumentManager->addDocument();
-        myFileFormatManager->importFile(doc.getScore(), path, *format);
+        auto doc = std::make_unique<Document>();
+        myFileFormatManager->importFile(doc->getScore(), path, *format);
         auto end = std::chrono::high_resolution_clock::now();
         qDebug() << "File loaded in"
                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start) .count()
                  << "ms";
 
-        doc.setFilename(path);
-        setPreviousDirectory(filename);
-        myRecentFiles->add(filename);
-        setupNewTab();
+        doc->setFilename(path);
+        addOpenedDocument(std::move(doc), filename);
     }
     catch (const std::exception &e)
     {
-        myDocumentManager->removeDocument(
-            myDocumentManager->getCurrentDocumentIndex());
-
         QMessageBox::warning(
             this, tr("Error Opening File"),
             tr("Error opening file: %1").arg(QString(e.what())));
     }
 }
 
+std::optional<FileFormat> PowerTabEditor::findFormatForOpening(
+    const QString &filename)
+{
+    int validationResult =
+        myDocumentManager->findDocument(Paths::fromQString(filename));
+    if (validationResult > -1)
+    {
+        qDebug() << "File: " << filename << " is already open";
+        myTabWidget->setCurrentIndex(validationResult);
+        return std::nullopt;
+    }
+
+    QFileInfo fileInfo(filename);
+    std::optional<FileFormat> format = myFileFormatManager->findFormat(
+                fileInfo.suffix().toStdString());
+
+    if (!format)
+    {
+        QMessageBox::warning(this, tr("Error Opening File"),
+                             tr("Unsupported file type."));
+    }
+
+    return format;
+}
+
+void PowerTabEditor::addOpenedDocument(std::unique_ptr<Document> doc,
+                                       const QString &filename)
+{
+    myDocumentManager->addDocument(std::move(doc));
+    setPreviousDirectory(filename);
+    myRecentFiles->add(filename);
+    setupNewTab();
+}
+
 void PowerTabEditor::switchTab(int index)
 {
     myDocumentManager->setCurrentDocumentIndex(index);
 
     if (index != -1)
     {
-        const Document &doc = myDocumentManager->getCurrentDocument();
-        myMixer->reset(doc.getScore());
-        myInstrumentPanel->reset(doc.getScore());
+        Document &doc = myDocumentManager->getCurrentDocument();
+        doc.ensureDecompressed();
         myPlaybackWidget->reset(doc);
         updateLocationLabel();
     }
-    else
-    {
-        myMixer->clear();
-        myInstrumentPanel->clear();
-    }
+
+    updateDockPanels();
 
     myUndoManager->setActiveStackIndex(index);
 
@@ -316,6 +608,11 @@ void PowerTabEditor::switchTab(int index)
 
 bool PowerTabEditor::closeTab(int index)
 {
+    // Make sure a background save isn't still using the document, and don't
+    // close the document if the save failed.
+    if (!finishPendingSave())
+        return false;
+
     // Prompt to save modified documents.
     if (isWindowModified())
     {
@@ -330,7 +627,7 @@ bool PowerTabEditor::closeTab(int index)
         const int ret = msg.exec();
         if (ret == QMessageBox::Save)
         {
-            if (!saveFile())
+            if (!saveFile() || !finishPendingSave())
                 return false;
         }
         else if (ret == QMessageBox::Cancel)
@@ -341,6 +638,7 @@ bool PowerTabEditor::closeTab(int index)
         startStopPlayback();
 
     myUndoManager->removeStack(index);
+    myAutosaveJournals.erase(myAutosaveJournals.begin() + index);
     myDocumentManager->removeDocument(index);
     delete myTabWidget->widget(index);
 
@@ -387,12 +685,45 @@ bool PowerTabEditor::saveFile(QString path)
         return false;
     }
 
-    auto path_str = Paths::fromQString(path);
+    // Only run one save at a time.
+    if (!finishPendingSave())
+        return false;
+
     Document &doc = myDocumentManager->getCurrentDocument();
 
+    PendingSave save;
+    save.myDocument = &doc;
+    save.myPath = path;
+    save.myIsPowerTab = (extension == "pt2");
+    save.myRevision = myUndoManager->getRevision(
+        myDocumentManager->getCurrentDocumentIndex());
+
+    // Serialize a copy of the score so that editing can continue while the
+    // file is written.
+    save.myResult = std::async(
+        std::launch::async,
+        [this, snapshot = doc.getScore().clone(),
+         path_str = Paths::fromQString(path), file_format = *format]() {
+            myFileFormatManager->exportFile(*snapshot, path_str, file_format);
+        });
+
+    myPendingSave = std::move(save);
+    mySaveTimer->start(50);
+    return true;
+}
+
+bool PowerTabEditor::finishPendingSave()
+{
+    if (!myPendingSave)
+        return true;
+
+    mySaveTimer->stop();
+    PendingSave save = std::move(*myPendingSave);
+    myPendingSave.reset();
+
     try
     {
-        myFileFormatManager->exportFile(doc.getScore(), path_str, *format);
+        save.myResult.get();
     }
     catch (const std::exception &e)
     {
@@ -403,27 +734,174 @@ bool PowerTabEditor::saveFile(QString path)
         return false;
     }
 
-    if (extension == "pt2")
+    QFileInfo info(save.myPath);
+
+    if (save.myIsPowerTab)
     {
-        doc.setFilename(path_str);
+        save.myDocument->setFilename(Paths::fromQString(save.myPath));
 
         // Update window title and tab bar.
-        updateWindowTitle();
+        if (myDocumentManager->hasOpenDocuments() &&
+            &myDocumentManager->getCurrentDocument() == save.myDocument)
+        {
+            updateWindowTitle();
+        }
+
         const QString filename = info.fileName();
-        myTabWidget->setTabText(myTabWidget->currentIndex(), filename);
-        myTabWidget->setTabToolTip(myTabWidget->currentIndex(), filename);
+        int docIndex = -1;
+        for (int i = 0; i < static_cast<int>(
+                                myDocumentManager->getDocumentListSize());
+             ++i)
+        {
+            if (&myDocumentManager->getDocument(i) == save.myDocument)
+                docIndex = i;
+        }
 
-        // Add to the recent files list and update the last used directory.
-        myRecentFiles->add(path);
-        setPreviousDirectory(path);
+        if (docIndex >= 0)
+        {
+            myTabWidget->setTabText(docIndex, filename);
+            myTabWidget->setTabToolTip(docIndex, filename);
+        }
 
-        // Mark the file as being in an unmodified state.
-        myUndoManager->setClean();
+        // Add to the recent files list and update the last used directory.
+        myRecentFiles->add(save.myPath);
+        setPreviousDirectory(save.myPath);
+
+        // Mark the file as being in an unmodified state, unless it was edited
+        // after the snapshot was taken. Closing a document waits for its save
+        // to finish, so it should still be open.
+        const bool modified =
+            docIndex < 0 ||
+            myUndoManager->getRevision(docIndex) != save.myRevision;
+        if (!modified)
+            myUndoManager->setClean(docIndex);
+
+        // If the document is unchanged, the autosave journal now only needs
+        // to track changes from the saved file. Otherwise, have the next
+        // autosave write the whole score, since the file that the journal's
+        // changes were based on has been replaced.
+        if (docIndex >= 0 && myAutosaveJournals[docIndex])
+        {
+            AutosaveJournal &journal = *myAutosaveJournals[docIndex];
+            try
+            {
+                if (modified)
+                    journal.markAllModified();
+                else
+                    journal.reset(save.myDocument->getFilename());
+            }
+            catch (const std::exception &e)
+            {
+                reportAutosaveError(e);
+            }
+        }
     }
 
     return true;
 }
 
+void PowerTabEditor::autosave()
+{
+    bool succeeded = true;
+    for (size_t i = 0; i < myAutosaveJournals.size(); ++i)
+    {
+        AutosaveJournal *journal = myAutosaveJournals[i].get();
+        if (!journal)
+            continue;
+
+        try
+        {
+            // Check whether the previous write succeeded, even if there
+            // aren't any new changes.
+            journal->flush();
+
+            if (journal->hasChanges())
+            {
+                journal->write(myDocumentManager->getDocument(
+                    static_cast<int>(i)).getScore());
+            }
+        }
+        catch (const std::exception &e)
+        {
+            succeeded = false;
+            reportAutosaveError(e);
+        }
+    }
+
+    if (succeeded)
+        myHasAutosaveError = false;
+}
+
+void PowerTabEditor::reportAutosaveError(const std::exception &e)
+{
+    if (myHasAutosaveError)
+        return;
+
+    myHasAutosaveError = true;
+    QMessageBox::warning(
+        this, tr("Error Autosaving"),
+        tr("Error updating the autosave data: %1\n\nUnsaved changes might "
+           "not be recoverable if the program crashes.")
+            .arg(QString(e.what())));
+}
+
+void PowerTabEditor::hibernateInactiveTabs()
+{
+    int timeout;
+    bool compress;
+    {
+        auto settings = mySettingsManager->getReadHandle();
+        timeout = settings->get(Settings::TabHibernateTimeout);
+        compress = settings->get(Settings::CompressHibernatedTabs);
+    }
+
+    const int currentIndex = myTabWidget->currentIndex();
+    for (int i = 0; i < myTabWidget->count(); ++i)
+    {
+        auto scorearea = dynamic_cast<ScoreArea *>(myTabWidget->widget(i));
+        const qint64 hiddenTime = scorearea->getHiddenTime();
+        if (i == currentIndex || hiddenTime < 0 ||
+            hiddenTime < timeout * 1000LL)
+        {
+            continue;
+        }
+
+        if (!scorearea->isHibernated())
+            scorearea->hibernate();
+
+        Document &doc = myDocumentManager->getDocument(i);
+        if (compress && !doc.isScoreCompressed())
+        {
+            // Write any unsaved changes to the journal first, so that the
+            // next autosave doesn't need to restore the score.
+            AutosaveJournal *journal = myAutosaveJournals[i].get();
+            try
+            {
+                if (journal && journal->hasChanges())
+                    journal->write(doc.getScore());
+            }
+            catch (const std::exception &e)
+            {
+                reportAutosaveError(e);
+            }
+
+            doc.compressScore();
+        }
+    }
+}
+
+AutosaveJournal *PowerTabEditor::getAutosaveJournal()
+{
+    if (!myDocumentManager->hasOpenDocuments())
+        return nullptr;
+
+    const int index = myDocumentManager->getCurrentDocumentIndex();
+    if (index < 0 || index >= static_cast<int>(myAutosaveJournals.size()))
+        return nullptr;
+
+    return myAutosaveJournals[index].get();
+}
+
 bool PowerTabEditor::saveFileAs()
 {
     const QString filter =
@@ -591,8 +1069,8 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
 
         const ScoreLocation &location = getLocation();
         myMidiPlayer.reset(
-            new MidiPlayer(*mySettingsManager, location,
-                           myPlaybackWidget->getPlaybackSpeed()));
+            new MidiPlayer(*mySettingsManager, *myMidiOutputService,
+                           location, myPlaybackWidget->getPlaybackSpeed()));
 
         connect(myMidiPlayer.get(), &MidiPlayer::playbackSystemChanged, this,
                 &PowerTabEditor::moveCaretToSystem);
@@ -602,6 +1080,11 @@ void PowerTabEditor::startStopPlayback(bool from_measure_start)
                 [this]() { startStopPlayback(); });
         connect(myPlaybackWidget, &PlaybackWidget::playbackSpeedChanged,
                 myMidiPlayer.get(), &MidiPlayer::changePlaybackSpeed);
+        connect(myMidiPlayer.get(), &MidiPlayer::playbackSpeedChanged,
+                myPlaybackWidget, &PlaybackWidget::setPlaybackSpeed);
+
+        if (myLoopCommand->isChecked())
+            myMidiPlayer->setLoopRegion(getLoopRegion(location));
 
         connect(myMidiPlayer.get(), &MidiPlayer::error, this, [=](const QString &msg) {
             QMessageBox::critical(this, tr("Midi Error"), msg);
@@ -643,8 +1126,7 @@ void PowerTabEditor::redrawScore()
     getScoreArea()->renderDocument(doc);
     updateCommands();
 
-    myMixer->reset(doc.getScore());
-    myInstrumentPanel->reset(doc.getScore());
+    updateDockPanels();
     myPlaybackWidget->reset(doc);
 }
 
@@ -807,7 +1289,8 @@ void PowerTabEditor::removeSelectedPositions()
 
 void PowerTabEditor::gotoBarline()
 {
-    GoToBarlineDialog dialog(this, getLocation().getScore());
+    GoToBarlineDialog dialog(this, getLocation().getScore(),
+                             getScoreArea()->getBarIndex());
 
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -1756,6 +2239,17 @@ void PowerTabEditor::closeEvent(QCloseEvent *event)
     QMainWindow::closeEvent(event);
 }
 
+void PowerTabEditor::paintEvent(QPaintEvent *event)
+{
+    QMainWindow::paintEvent(event);
+
+    if (!myIsPainted)
+    {
+        myIsPainted = true;
+        emit firstPaintFinished();
+    }
+}
+
 void PowerTabEditor::dragEnterEvent(QDragEnterEvent *event)
 {
     if (event->mimeData()->hasUrls())
@@ -1773,8 +2267,12 @@ void PowerTabEditor::dragEnterEvent(QDragEnterEvent *event)
 void PowerTabEditor::dropEvent(QDropEvent *event)
 {
     Q_ASSERT(event->mimeData()->hasUrls());
+
+    QStringList files;
     for (const QUrl &url : event->mimeData()->urls())
-        openFile(url.toLocalFile());
+        files.append(url.toLocalFile());
+
+    openFiles(files);
 }
 
 QString PowerTabEditor::getApplicationName() const
@@ -1815,6 +2313,8 @@ void PowerTabEditor::updateWindowTitle()
 
 void PowerTabEditor::createCommands()
 {
+    Tracing::Span span("PowerTabEditor::createCommands");
+
     // File-related commands.
     myNewDocumentCommand = new Command(tr("&New"), "File.New",
                                        QKeySequence::New, this);
@@ -1938,6 +2438,12 @@ void PowerTabEditor::createCommands()
     connect(myMetronomeCommand, &QAction::triggered, this,
             &PowerTabEditor::toggleMetronome);
 
+    myLoopCommand = new Command(tr("Loop Selection"), "Playback.Loop",
+                                QKeySequence(), this);
+    myLoopCommand->setCheckable(true);
+    connect(myLoopCommand, &QAction::triggered, this,
+            &PowerTabEditor::toggleLoop);
+
     // Section navigation actions.
     myFirstSectionCommand =
         new Command(tr("First Section"), "Position.Section.FirstSection",
@@ -2548,6 +3054,8 @@ void PowerTabEditor::createCommands()
 
 void PowerTabEditor::loadKeyboardShortcuts()
 {
+    Tracing::Span span("PowerTabEditor::loadKeyboardShortcuts");
+
     auto settings = mySettingsManager->getReadHandle();
     for (auto command : getCommands())
         command->load(*settings);
@@ -2583,13 +3091,15 @@ void PowerTabEditor::createMixer()
     QScrollArea *scroll = new QScrollArea(this);
     scroll->setMinimumSize(0, 150);
 
-    myMixer = new Mixer(scroll, *myTuningDictionary, myPlayerEditPubSub,
-                        myPlayerRemovePubSub);
-
-    scroll->setWidget(myMixer);
     myMixerDockWidget->setWidget(scroll);
     addDockWidget(Qt::BottomDockWidgetArea, myMixerDockWidget);
 
+    connect(myMixerDockWidget, &QDockWidget::visibilityChanged, this,
+            [=](bool visible) {
+                if (visible)
+                    resetMixer();
+            });
+
     myPlayerEditPubSub.subscribe([=](int index, const Player & player,
                                  bool undoable) {
         editPlayer(index, player, undoable);
@@ -2609,13 +3119,15 @@ void PowerTabEditor::createInstrumentPanel()
     QScrollArea *scroll = new QScrollArea(this);
     scroll->setMinimumSize(0, 150);
 
-    myInstrumentPanel = new InstrumentPanel(scroll, myInstrumentEditPubSub,
-                                            myInstrumentRemovePubSub);
-
-    scroll->setWidget(myInstrumentPanel);
     myInstrumentDockWidget->setWidget(scroll);
     addDockWidget(Qt::BottomDockWidgetArea, myInstrumentDockWidget);
 
+    connect(myInstrumentDockWidget, &QDockWidget::visibilityChanged, this,
+            [=](bool visible) {
+                if (visible)
+                    resetInstrumentPanel();
+            });
+
     myInstrumentEditPubSub.subscribe([=](int index, const Instrument &instrument) {
         editInstrument(index, instrument);
     });
@@ -2624,6 +3136,57 @@ void PowerTabEditor::createInstrumentPanel()
     });
 }
 
+void PowerTabEditor::resetMixer()
+{
+    if (!myMixer)
+    {
+        Tracing::Span span("PowerTabEditor::resetMixer");
+
+        auto scroll = static_cast<QScrollArea *>(myMixerDockWidget->widget());
+        myMixer = new Mixer(scroll, *myTuningDictionary, myPlayerEditPubSub,
+                            myPlayerRemovePubSub);
+        scroll->setWidget(myMixer);
+    }
+
+    if (myDocumentManager->hasOpenDocuments())
+        myMixer->reset(myDocumentManager->getCurrentDocument().getScore());
+    else
+        myMixer->clear();
+}
+
+void PowerTabEditor::resetInstrumentPanel()
+{
+    if (!myInstrumentPanel)
+    {
+        Tracing::Span span("PowerTabEditor::resetInstrumentPanel");
+
+        auto scroll =
+            static_cast<QScrollArea *>(myInstrumentDockWidget->widget());
+        myInstrumentPanel = new InstrumentPanel(scroll, myInstrumentEditPubSub,
+                                                myInstrumentRemovePubSub);
+        scroll->setWidget(myInstrumentPanel);
+    }
+
+    if (myDocumentManager->hasOpenDocuments())
+    {
+        myInstrumentPanel->reset(
+            myDocumentManager->getCurrentDocument().getScore());
+    }
+    else
+        myInstrumentPanel->clear();
+}
+
+void PowerTabEditor::updateDockPanels()
+{
+    // Avoid rebuilding the panels while they are hidden (e.g. during startup
+    // or if the user has closed them). They are brought up to date when their
+    // dock widgets are shown again.
+    if (myMixerDockWidget->isVisible())
+        resetMixer();
+    if (myInstrumentDockWidget->isVisible())
+        resetInstrumentPanel();
+}
+
 Command *PowerTabEditor::createCommandWrapper(
     QAction *action, const QString &id, const QKeySequence &defaultShortcut,
     QObject *parent)
@@ -2687,6 +3250,8 @@ void PowerTabEditor::createPositionPropertyCommand(
 
 void PowerTabEditor::createMenus()
 {
+    Tracing::Span span("PowerTabEditor::createMenus");
+
     // File Menu.
     myFileMenu = menuBar()->addMenu(tr("&File"));
     myFileMenu->addAction(myNewDocumentCommand);
@@ -2729,6 +3294,7 @@ void PowerTabEditor::createMenus()
     myPlaybackMenu->addAction(myStopCommand);
     myPlaybackMenu->addAction(myRewindCommand);
     myPlaybackMenu->addAction(myMetronomeCommand);
+    myPlaybackMenu->addAction(myLoopCommand);
 
     // Position Menu.
     myPositionMenu = menuBar()->addMenu(tr("&Position"));
@@ -2922,6 +3488,8 @@ void PowerTabEditor::createMenus()
 
 void PowerTabEditor::createTabArea()
 {
+    Tracing::Span span("PowerTabEditor::createTabArea");
+
     myTabWidget = new QTabWidget(this);
     myTabWidget->setDocumentMode(true);
     myTabWidget->setTabsClosable(true);
@@ -2944,6 +3512,9 @@ void PowerTabEditor::createTabArea()
     connect(myPlaybackWidget, &PlaybackWidget::zoomChanged, this,
             &PowerTabEditor::updateZoom);
 
+    connect(myPlaybackWidget, &PlaybackWidget::seekRequested, this,
+            &PowerTabEditor::moveCaretToTime);
+
     auto update_metronome_state = [&]() {
         auto settings = mySettingsManager->getReadHandle();
         myMetronomeCommand->setChecked(
@@ -3024,6 +3595,22 @@ void PowerTabEditor::setupNewTab()
 
     myUndoManager->addNewUndoStack();
 
+    // Track unsaved changes so that they can be recovered after a crash.
+    std::unique_ptr<AutosaveJournal> journal;
+    try
+    {
+        std::optional<Paths::path> baseFile;
+        if (doc.hasFilename())
+            baseFile = doc.getFilename();
+
+        journal = std::make_unique<AutosaveJournal>(getAutosaveDir(), baseFile);
+    }
+    catch (const std::exception &e)
+    {
+        reportAutosaveError(e);
+    }
+    myAutosaveJournals.push_back(std::move(journal));
+
     QString filename = "Untitled";
     if (doc.hasFilename())
         filename = Paths::toQString(doc.getFilename());
@@ -3053,8 +3640,7 @@ void PowerTabEditor::setupNewTab()
     const int tabIndex = myTabWidget->addTab(scorearea, title);
     myTabWidget->setTabToolTip(tabIndex, fileInfo.fileName());
 
-    myMixer->reset(doc.getScore());
-    myInstrumentPanel->reset(doc.getScore());
+    updateDockPanels();
     myPlaybackWidget->reset(doc);
 
     // Switch to the new document.
@@ -3336,6 +3922,7 @@ void PowerTabEditor::enableEditing(bool enable)
         myPlayPauseCommand->setEnabled(true);
         myRewindCommand->setEnabled(true);
         myMetronomeCommand->setEnabled(true);
+        myLoopCommand->setEnabled(true);
         myStopCommand->setEnabled(myIsPlaying);
     }
 
@@ -3397,6 +3984,18 @@ void PowerTabEditor::toggleMetronome()
     settings->set(Settings::MetronomeEnabled, myMetronomeCommand->isChecked());
 }
 
+void PowerTabEditor::toggleLoop()
+{
+    // Switch the loop region without restarting playback.
+    if (myMidiPlayer)
+    {
+        myMidiPlayer->setLoopRegion(
+            myLoopCommand->isChecked()
+                ? std::optional(getLoopRegion(getLocation()))
+                : std::nullopt);
+    }
+}
+
 void PowerTabEditor::updateActiveVoice(int voice)
 {
     getLocation().setVoiceIndex(voice);
@@ -3419,6 +4018,29 @@ void PowerTabEditor::updateLocationLabel()
 {
     myPlaybackWidget->updateLocationLabel(
         Util::toString(getCaret().getLocation()));
+
+    // Display the time at the start of the caret's bar.
+    const PerformanceMap &map =
+        myDocumentManager->getCurrentDocument().getPerformanceMap();
+    const ScoreLocation &location = getLocation();
+    const PerformanceMap::Bar *bar = map.findBar(SystemLocation(
+        location.getSystemIndex(), location.getPositionIndex()));
+
+    myPlaybackWidget->updateTime(bar ? bar->myStartTime / 1000 : 0,
+                                 map.getDuration() / 1000);
+}
+
+void PowerTabEditor::moveCaretToTime(int msec)
+{
+    const PerformanceMap &map =
+        myDocumentManager->getCurrentDocument().getPerformanceMap();
+    const PerformanceMap::Bar *bar =
+        map.findBarAtTime(static_cast<int64_t>(msec) * 1000);
+    if (!bar)
+        return;
+
+    getCaret().moveToSystem(bar->myLocation.getSystem(), true);
+    getCaret().moveToPosition(bar->myLocation.getPosition());
 }
 
 void PowerTabEditor::editKeySignature(const ScoreLocation &keyLocation)
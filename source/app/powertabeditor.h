@@ -19,23 +19,34 @@
 #define APP_POWERTABEDITOR_H
 
 #include <QMainWindow>
+#include <QStringList>
 
 #include <app/pubsub/instrumentpubsub.h>
 #include <app/pubsub/playerpubsub.h>
+#include <cstdint>
+#include <formats/fileformat.h>
+#include <future>
 #include <memory>
+#include <optional>
 #include <score/position.h>
 #include <string>
 #include <vector>
 
+class AutosaveJournal;
 class Caret;
 class Command;
+class Document;
+class DocumentLoader;
 class DocumentManager;
 class FileFormatManager;
 class InstrumentPanel;
+class MidiOutputService;
 class MidiPlayer;
 class Mixer;
 class PlaybackWidget;
 class QActionGroup;
+class QProgressDialog;
+class QTimer;
 class RecentFiles;
 class ScoreArea;
 class ScoreLocation;
@@ -51,9 +62,28 @@ public:
     PowerTabEditor();
     ~PowerTabEditor();
 
-    /// Opens the given list of files.
+    /// Opens the given list of files. If there are several files, they are
+    /// imported in the background and a tab is added for each document as soon
+    /// as it has been loaded.
     void openFiles(const QStringList &files);
 
+    /// Offers to recover any documents with unsaved changes from a previous
+    /// session that did not exit normally.
+    void recoverAutosavedDocuments();
+
+    /// Offers to recover autosaved documents and then opens the given files.
+    /// This is deferred until the event loop is running, so that the window
+    /// appears quickly even if the files are slow to load.
+    /// @param recoverDocuments Whether to offer to recover autosaved
+    /// documents.
+    void finishStartup(const QStringList &files, bool recoverDocuments = true);
+
+signals:
+    /// Emitted when the window has been painted for the first time.
+    void firstPaintFinished();
+    /// Emitted once the work requested by finishStartup() has been done.
+    void startupFinished();
+
 private slots:
     /// Creates a new (blank) document.
     void createNewDocument();
@@ -268,6 +298,9 @@ protected:
     /// Performs some final actions before exiting.
     virtual void closeEvent(QCloseEvent*) override;
 
+    /// Reports when the window is first painted, for the startup benchmark.
+    virtual void paintEvent(QPaintEvent *event) override;
+
     /// Accept drag events.
     virtual void dragEnterEvent(QDragEnterEvent *event) override;
 
@@ -282,10 +315,24 @@ private:
 
     /// Create all of the commands for the application.
     void createCommands();
-    /// Build the mixer widget.
+    /// Build the dock widget for the mixer. The mixer itself is not created
+    /// until the dock widget is first shown.
     void createMixer();
-    /// Build the instrument panel.
+    /// Build the dock widget for the instrument panel. The panel itself is not
+    /// created until the dock widget is first shown.
     void createInstrumentPanel();
+    /// Creates the mixer if necessary, and updates it for the current
+    /// document.
+    void resetMixer();
+    /// Creates the instrument panel if necessary, and updates it for the
+    /// current document.
+    void resetInstrumentPanel();
+    /// Updates the mixer and instrument panel if they are visible. Hidden
+    /// panels are updated when they are next shown.
+    void updateDockPanels();
+
+    /// Opens the files passed to finishStartup().
+    void runDeferredStartup();
 
     /// Load any custom keyboard shortcuts.
     void loadKeyboardShortcuts();
@@ -327,6 +374,17 @@ private:
     void createTabArea();
     /// Updates the last directory that a file was opened from.
     void setPreviousDirectory(const QString &fileName);
+    /// Returns the format to import the file with, or an empty value if the
+    /// file cannot be opened. If the file is already open, its tab is
+    /// activated instead.
+    std::optional<FileFormat> findFormatForOpening(const QString &filename);
+    /// Adds a document that was loaded from the given file and sets up its
+    /// tab.
+    void addOpenedDocument(std::unique_ptr<Document> doc,
+                           const QString &filename);
+    /// Adds tabs for any documents that have finished loading in the
+    /// background, and updates the progress dialog.
+    void processLoadedDocuments();
     /// Sets up the UI for the current document after it has been opened.
     void setupNewTab();
     /// Updates whether menu items are enabled, checked, etc. depending on the
@@ -341,6 +399,8 @@ private:
     void stopPlayback();
     /// Toggles the metronome on or off.
     void toggleMetronome();
+    /// Starts or stops repeating the selected bars during playback.
+    void toggleLoop();
     /// Sets the current voice that is being edited.
     void updateActiveVoice(int);
     /// Sets the current score filter.
@@ -349,10 +409,27 @@ private:
     void updateZoom(double percent);
     /// Updates the playback widget with the caret's current location.
     void updateLocationLabel();
+    /// Moves the caret to the bar that is played at the given time.
+    void moveCaretToTime(int msec);
 
-    /// Saves the current document to the specified path.
-    /// @return True if the file was successfully saved.
+    /// Starts saving a snapshot of the current document to the specified
+    /// path in the background. Use finishPendingSave() to wait for the result.
+    /// @return True if the save was started.
     bool saveFile(QString path);
+    /// Waits for any background save to complete and updates the document
+    /// (filename, modified status, etc) if it succeeded.
+    /// @return False if the save failed.
+    bool finishPendingSave();
+    /// Writes any unsaved changes to the autosave journals.
+    void autosave();
+    /// Returns the autosave journal for the active document, if there is one.
+    AutosaveJournal *getAutosaveJournal();
+    /// Warns that unsaved changes may not be recoverable. This is only shown
+    /// once until an autosave succeeds again.
+    void reportAutosaveError(const std::exception &e);
+    /// Releases the rendered scores of tabs that have been hidden for longer
+    /// than the hibernation timeout, and optionally compresses their scores.
+    void hibernateInactiveTabs();
 
     /// Adds or removes a rest at the current location.
     void editRest(Position::DurationType duration);
@@ -392,8 +469,40 @@ private:
     std::unique_ptr<DocumentManager> myDocumentManager;
     std::unique_ptr<FileFormatManager> myFileFormatManager;
     std::unique_ptr<UndoManager> myUndoManager;
+    /// Shared by all playback sessions, so it must outlive the MIDI player.
+    std::unique_ptr<MidiOutputService> myMidiOutputService;
     std::unique_ptr<MidiPlayer> myMidiPlayer;
     std::unique_ptr<TuningDictionary> myTuningDictionary;
+    /// Imports files in the background when several files are opened at once.
+    std::unique_ptr<DocumentLoader> myDocumentLoader;
+    QProgressDialog *myLoadProgressDialog;
+    QTimer *myLoadTimer;
+    /// Errors from background imports, which are reported once all of the
+    /// files have been processed.
+    QStringList myLoadErrors;
+
+    /// A save that is running in the background.
+    struct PendingSave
+    {
+        std::future<void> myResult;
+        Document *myDocument;
+        QString myPath;
+        bool myIsPowerTab;
+        /// The document's revision when the snapshot was taken, to check
+        /// whether the document was modified while saving.
+        uint64_t myRevision;
+    };
+    std::optional<PendingSave> myPendingSave;
+    /// Polls for the completion of a background save.
+    QTimer *mySaveTimer;
+    /// Autosave journals for each open document (or null if the journal
+    /// could not be created).
+    std::vector<std::unique_ptr<AutosaveJournal>> myAutosaveJournals;
+    QTimer *myAutosaveTimer;
+    /// Whether an autosave error has been reported since the last successful
+    /// autosave.
+    bool myHasAutosaveError;
+    QTimer *myHibernateTimer;
     PlayerEditPubSub myPlayerEditPubSub;
     PlayerRemovePubSub myPlayerRemovePubSub;
     InstrumentEditPubSub myInstrumentEditPubSub;
@@ -413,6 +522,16 @@ private:
     PlaybackWidget *myPlaybackWidget;
     QWidget *myPlaybackArea;
 
+    /// Whether the window has been painted yet.
+    bool myIsPainted;
+    /// The files to open once the event loop is running.
+    std::optional<QStringList> myStartupFiles;
+    /// Whether to offer to recover autosaved documents at startup.
+    bool myRecoverOnStartup;
+    /// Whether the files passed to finishStartup() are still being loaded in
+    /// the background.
+    bool myIsLoadingStartupFiles;
+
     QMenu *myFileMenu;
     Command *myNewDocumentCommand;
     Command *myOpenFileCommand;
@@ -442,6 +561,7 @@ private:
     Command *myStopCommand;
     Command *myRewindCommand;
     Command *myMetronomeCommand;
+    Command *myLoopCommand;
 
     QMenu *myPositionMenu;
     QMenu *myPositionSectionMenu;
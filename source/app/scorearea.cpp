@@ -19,6 +19,7 @@
 
 #include <app/documentmanager.h>
 #include <app/pubsub/clickpubsub.h>
+#include <cassert>
 #include <chrono>
 #include <future>
 #include <painters/caretpainter.h>
@@ -29,7 +30,10 @@
 #include <QGraphicsSceneDragDropEvent>
 #include <QPrinter>
 #include <QScrollBar>
+#include <QTimer>
 #include <score/score.h>
+#include <score/utils/barindex.h>
+#include <util/tracing.h>
 
 static const double SYSTEM_SPACING = 50;
 
@@ -40,8 +44,10 @@ void ScoreArea::Scene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
 
 ScoreArea::ScoreArea(QWidget *parent)
     : QGraphicsView(parent),
+      myDocument(nullptr),
       myScoreInfoBlock(nullptr),
       myCaretPainter(nullptr),
+      myIsHibernated(false),
       myClickPubSub(std::make_shared<ClickPubSub>())
 {
     setScene(&myScene);
@@ -53,13 +59,19 @@ ScoreArea::ScoreArea(QWidget *parent)
     setBackgroundBrush(QBrush(Qt::white, Qt::SolidPattern));
 }
 
-void ScoreArea::renderDocument(const Document &document)
+void ScoreArea::renderDocument(Document &document)
 {
+    Tracing::Span span("ScoreArea::renderDocument");
+
+    document.ensureDecompressed();
+
     myScene.clear();
     myRenderedSystems.clear();
     myDocument = &document;
+    myIsHibernated = false;
 
     const Score &score = document.getScore();
+    myBarIndex = std::make_unique<BarIndex>(score);
 
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -129,10 +141,17 @@ void ScoreArea::renderDocument(const Document &document)
 
 void ScoreArea::redrawSystem(int index)
 {
+    // The system will be drawn when the score is rendered again.
+    if (myIsHibernated)
+        return;
+
     // Delete and remove the system from the scene.
     delete myRenderedSystems.takeAt(index);
 
     const Score &score = myDocument->getScore();
+    if (myBarIndex)
+        myBarIndex->invalidate(index);
+
     SystemRenderer render(this, score, myDocument->getViewOptions());
     QGraphicsItem *newSystem = render(score.getSystems()[index], index);
 
@@ -164,6 +183,45 @@ void ScoreArea::redrawSystem(int index)
     myCaretPainter->updatePosition();
 }
 
+const BarIndex &ScoreArea::getBarIndex() const
+{
+    if (!myBarIndex)
+    {
+        assert(myDocument);
+        // This restores the score if it was compressed.
+        myBarIndex = std::make_unique<BarIndex>(myDocument->getScore());
+    }
+
+    return *myBarIndex;
+}
+
+void ScoreArea::hibernate()
+{
+    if (myIsHibernated || !myDocument)
+        return;
+
+    myHibernatedScroll = QPoint(horizontalScrollBar()->value(),
+                                verticalScrollBar()->value());
+
+    // This also deletes the caret painter.
+    myScene.clear();
+    myRenderedSystems.clear();
+    myScoreInfoBlock = nullptr;
+    myCaretPainter = nullptr;
+    myBarIndex.reset();
+    myIsHibernated = true;
+}
+
+bool ScoreArea::isHibernated() const
+{
+    return myIsHibernated;
+}
+
+qint64 ScoreArea::getHiddenTime() const
+{
+    return myHiddenTimer.isValid() ? myHiddenTimer.elapsed() : -1;
+}
+
 void ScoreArea::print(QPrinter &printer)
 {
     QPainter painter;
@@ -235,13 +293,41 @@ void ScoreArea::adjustScroll()
 
 void ScoreArea::focusInEvent(QFocusEvent *)
 {
-    myScene.update(myCaretPainter->sceneBoundingRect());
+    if (myCaretPainter)
+        myScene.update(myCaretPainter->sceneBoundingRect());
 }
 
 void ScoreArea::focusOutEvent(QFocusEvent *)
 {
     // Redraw the caret to indicate that the score has lost focus.
-    myScene.update(myCaretPainter->sceneBoundingRect());
+    if (myCaretPainter)
+        myScene.update(myCaretPainter->sceneBoundingRect());
+}
+
+void ScoreArea::showEvent(QShowEvent *event)
+{
+    myHiddenTimer.invalidate();
+
+    if (myIsHibernated)
+    {
+        renderDocument(*myDocument);
+
+        // Restore the scroll position once the scroll bars have been updated
+        // for the new scene.
+        const QPoint scroll = myHibernatedScroll;
+        QTimer::singleShot(0, this, [=]() {
+            horizontalScrollBar()->setValue(scroll.x());
+            verticalScrollBar()->setValue(scroll.y());
+        });
+    }
+
+    QGraphicsView::showEvent(event);
+}
+
+void ScoreArea::hideEvent(QHideEvent *event)
+{
+    myHiddenTimer.start();
+    QGraphicsView::hideEvent(event);
 }
 
 void ScoreArea::refreshZoom()
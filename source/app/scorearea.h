@@ -19,10 +19,12 @@
 #define APP_SCOREAREA_H
 
 #include <memory>
+#include <QElapsedTimer>
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <score/staff.h>
 
+class BarIndex;
 class CaretPainter;
 class ClickPubSub;
 class Document;
@@ -43,7 +45,9 @@ class ScoreArea : public QGraphicsView
 public:
     explicit ScoreArea(QWidget *parent);
 
-    void renderDocument(const Document &document);
+    /// Draws the document's score, which is first restored if it was
+    /// compressed while the view was hibernated.
+    void renderDocument(Document &document);
 
     void refreshZoom();
 
@@ -53,21 +57,43 @@ public:
     /// necessary.
     void redrawSystem(int index);
 
+    /// Returns the bar numbers for the score being displayed. If the view is
+    /// hibernated, the index is rebuilt from the document's score.
+    const BarIndex &getBarIndex() const;
+
+    /// Releases the rendered score to save memory while the view is hidden.
+    /// The score is rendered again when the view is next shown.
+    void hibernate();
+    bool isHibernated() const;
+
+    /// Returns how long the view has been hidden (in milliseconds), or -1 if
+    /// it is visible.
+    qint64 getHiddenTime() const;
+
     std::shared_ptr<ClickPubSub> getClickPubSub() const;
 
 protected:
     virtual void focusInEvent(QFocusEvent *event) override;
     virtual void focusOutEvent(QFocusEvent *event) override;
+    virtual void showEvent(QShowEvent *event) override;
+    virtual void hideEvent(QHideEvent *event) override;
 
 private:
     /// Adjusts the scroll location whenever the caret moves.
     void adjustScroll();
 
     Scene myScene;
-    const Document *myDocument;
+    Document *myDocument;
     QGraphicsItem *myScoreInfoBlock;
     QList<QGraphicsItem *> myRenderedSystems;
     CaretPainter *myCaretPainter;
+    /// Built on demand, since it is released when the view is hibernated.
+    mutable std::unique_ptr<BarIndex> myBarIndex;
+
+    bool myIsHibernated;
+    /// The scroll position when the view was hibernated.
+    QPoint myHibernatedScroll;
+    QElapsedTimer myHiddenTimer;
 
     std::shared_ptr<ClickPubSub> myClickPubSub;
 };
@@ -33,6 +33,15 @@ const Setting<std::vector<std::string>> RecentFiles("app/recent_files", {});
 const Setting<bool> OpenFilesInNewWindow("app/open_files_in_new_window",
                                          false);
 
+const Setting<int> AutosaveInterval("app/autosave_interval", 10);
+
+const Setting<int> TabHibernateTimeout("app/tab_hibernate_timeout", 120);
+
+const Setting<bool> CompressHibernatedTabs("app/compress_hibernated_tabs",
+                                           false);
+
+const Setting<bool> RecordTrace("app/record_trace", false);
+
 const Setting<std::string> DefaultInstrumentName("app/default_instrument_name",
                                                  "Untitled");
 
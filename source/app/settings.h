@@ -30,6 +30,17 @@ namespace Settings
     extern const Setting<QByteArray> WindowState;
     extern const Setting<std::vector<std::string>> RecentFiles;
     extern const Setting<bool> OpenFilesInNewWindow;
+    /// How often (in seconds) unsaved changes are written to the autosave
+    /// journal, or 0 to disable autosaving.
+    extern const Setting<int> AutosaveInterval;
+    /// How long (in seconds) a document tab can be hidden before its rendered
+    /// score is released, or 0 to keep every tab rendered.
+    extern const Setting<int> TabHibernateTimeout;
+    /// Whether the scores of hibernated tabs are also compressed in memory.
+    extern const Setting<bool> CompressHibernatedTabs;
+    /// Whether a performance trace is recorded and written to the user data
+    /// directory on exit. Takes effect on the next startup.
+    extern const Setting<bool> RecordTrace;
 
     extern const Setting<std::string> DefaultInstrumentName;
     extern const Setting<int> DefaultInstrumentPreset;
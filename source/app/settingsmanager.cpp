@@ -20,13 +20,21 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <iostream>
+#include <util/tracing.h>
 
 #ifndef __APPLE__
 static const char *theSettingsFilename = "settings.json";
 #endif
 
+SettingsManager::SettingsManager()
+    : mySnapshot(std::make_shared<const SettingsTree>())
+{
+}
+
 void SettingsManager::load(const boost::filesystem::path &dir)
 {
+    Tracing::Span span("SettingsManager::load");
+
 #ifdef __APPLE__
     if (!boost::filesystem::exists(dir))
         return;
@@ -18,86 +18,93 @@
 #ifndef APP_SETTINGSMANAGER_H
 #define APP_SETTINGSMANAGER_H
 
+#include <atomic>
 #include <boost/filesystem/path.hpp>
 #include <boost/signals2/signal.hpp>
+#include <memory>
 #include <mutex>
+#include <type_traits>
 #include <util/settingstree.h>
 
+/// Manages the application's settings, which can be accessed from multiple
+/// threads (e.g. the MIDI thread).
+/// Readers receive an immutable snapshot of the settings and never block,
+/// while each writer modifies a private copy that replaces the current
+/// snapshot once the write handle is released.
 class SettingsManager
 {
 public:
     typedef boost::signals2::signal<void()> SettingsChangedSignal;
 
-    /// Handle to ensure the settings aren't modified while being accessed by
-    /// another thread (e.g. the MIDI thread).
-    template <typename T>
-    class Handle
+    /// Provides access to an immutable snapshot of the settings. The snapshot
+    /// is not affected by any writes that occur while the handle is alive.
+    class ReadHandle
     {
     public:
-        Handle(const Handle &) = delete;
-        Handle& operator=(const Handle &) = delete;
+        const SettingsTree *operator->() const { return mySettings.get(); }
+        const SettingsTree &operator*() const { return *mySettings; }
 
-        // TODO - change to a defaulted move constructor when VS2013 is no
-        // longer supported.
-        Handle(Handle &&other)
-            : mySettings(other.mySettings), myLock(std::move(other.myLock))
-        {
-
-        }
-
-        T *operator->() const { return &mySettings; }
-        T &operator*() const { return mySettings; }
-
-    protected:
-        Handle(T &settings, std::mutex &mutex)
-            : mySettings(settings), myLock(mutex)
+    private:
+        explicit ReadHandle(std::shared_ptr<const SettingsTree> settings)
+            : mySettings(std::move(settings))
         {
         }
 
         friend class SettingsManager;
 
-        T &mySettings;
-        std::unique_lock<std::mutex> myLock;
+        std::shared_ptr<const SettingsTree> mySettings;
     };
 
-    using ReadHandle = Handle<const SettingsTree>;
-
-    class WriteHandle : public Handle<SettingsTree>
+    /// Provides write access to a copy of the settings, which is published
+    /// when the handle is destroyed. Only one write handle can exist at a time.
+    class WriteHandle
     {
     public:
-        WriteHandle(SettingsManager &manager)
-            : Handle(manager.mySettings, manager.myMutex),
-              mySignal(manager.mySettingsChangedSignal)
-        {
-        }
+        WriteHandle(const WriteHandle &) = delete;
+        WriteHandle &operator=(const WriteHandle &) = delete;
+        WriteHandle(WriteHandle &&other) = default;
 
         ~WriteHandle()
         {
-            // Unlock before signalling to avoid deadlocks if callbacks read the
-            // settings.
+            if (!mySettings)
+                return;
+
+            myManager->publish(std::move(mySettings));
+
+            // Unlock before signalling to avoid deadlocks if callbacks modify
+            // the settings.
             myLock.unlock();
-            mySignal();
+            myManager->mySettingsChangedSignal();
         }
 
-        // TODO - change to a defaulted move constructor when VS2013 is no
-        // longer supported.
-        WriteHandle(WriteHandle &&other)
-            : Handle<SettingsTree>(std::move(other)), mySignal(other.mySignal)
+        SettingsTree *operator->() const { return mySettings.get(); }
+        SettingsTree &operator*() const { return *mySettings; }
+
+    private:
+        explicit WriteHandle(SettingsManager &manager)
+            : myManager(&manager), myLock(manager.myWriteMutex)
         {
+            // Copy the current snapshot only after acquiring the lock, so that
+            // changes from a concurrent writer are not lost.
+            mySettings =
+                std::make_unique<SettingsTree>(*manager.getReadHandle());
         }
 
-    private:
-        SettingsChangedSignal &mySignal;
+        friend class SettingsManager;
+
+        SettingsManager *myManager;
+        std::unique_lock<std::mutex> myLock;
+        std::unique_ptr<SettingsTree> mySettings;
     };
 
-    SettingsManager() = default;
+    SettingsManager();
     SettingsManager(const SettingsManager &) = delete;
     SettingsManager &operator=(const SettingsManager &) = delete;
 
-    /// Obtain read access to the settings.
+    /// Obtain read access to the current settings.
     ReadHandle getReadHandle() const
     {
-        return ReadHandle(mySettings, myMutex);
+        return ReadHandle(std::atomic_load(&mySnapshot));
     }
 
     /// Obtain write access to the settings.
@@ -120,13 +127,63 @@ public:
     void save(const boost::filesystem::path &dir) const;
 
 private:
-    template <typename T>
-    friend class Handle;
+    void publish(std::shared_ptr<const SettingsTree> settings)
+    {
+        std::atomic_store(&mySnapshot, std::move(settings));
+    }
 
-    SettingsTree mySettings;
-    mutable std::mutex myMutex;
+    /// The current settings. This is only ever replaced, never modified.
+    std::shared_ptr<const SettingsTree> mySnapshot;
+    /// Serializes writers.
+    std::mutex myWriteMutex;
 
     SettingsChangedSignal mySettingsChangedSignal;
 };
 
+/// Holds the current value of a setting, which is looked up again only when
+/// the settings are modified. Reading the value never blocks and does not
+/// involve any key lookups, so this is suitable for values that are checked
+/// frequently (e.g. by the MIDI thread during playback).
+template <typename T>
+class CachedSetting
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "The setting's value must be usable with std::atomic");
+
+public:
+    CachedSetting(SettingsManager &manager, Setting<T> setting)
+        : myManager(manager), mySetting(std::move(setting))
+    {
+        // Subscribe before reading the initial value so that no changes are
+        // missed.
+        myConnection = myManager.subscribeToChanges([this]() { reload(); });
+        reload();
+    }
+
+    CachedSetting(const CachedSetting &) = delete;
+    CachedSetting &operator=(const CachedSetting &) = delete;
+
+    T get() const
+    {
+        return myValue.load(std::memory_order_relaxed);
+    }
+
+    operator T() const
+    {
+        return get();
+    }
+
+private:
+    void reload()
+    {
+        myValue.store(myManager.getReadHandle()->get(mySetting),
+                      std::memory_order_relaxed);
+    }
+
+    SettingsManager &myManager;
+    const Setting<T> mySetting;
+    std::atomic<T> myValue;
+    boost::signals2::scoped_connection myConnection;
+};
+
 #endif
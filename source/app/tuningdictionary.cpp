@@ -23,11 +23,14 @@
 #include <boost/filesystem/operations.hpp>
 #include <score/serialization.h>
 #include <stdexcept>
+#include <util/tracing.h>
 
 static const char *theTuningDictFilename = "tunings.json";
 
 std::vector<Tuning> TuningDictionary::load()
 {
+    Tracing::Span span("TuningDictionary::load");
+
     for (boost::filesystem::path dir : Paths::getDataDirs())
     {
         auto path = dir / theTuningDictFilename;
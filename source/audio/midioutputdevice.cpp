@@ -17,50 +17,14 @@
   
 #include "midioutputdevice.h"
 
-#include <RtMidi.h>
-#include <exception>
+#include <audio/midisink.h>
+#include <cassert>
 #include <score/dynamic.h>
 #include <score/generalmidi.h>
-#include <cassert>
 
-#ifdef __APPLE__
-#include "midisoftwaresynth.h"
-#endif
-
-MidiOutputDevice::MidiOutputDevice() : myMidiOut(nullptr)
+MidiOutputDevice::MidiOutputDevice(MidiSink &sink) : mySink(sink)
 {
-    // Initialize the OSX software synth.
-#ifdef __APPLE__
-    try
-    {
-        static MidiSoftwareSynth synth;
-        synth.initialize();
-    }
-    catch (std::exception &e)
-    {
-        std::cerr << e.what() << std::endl;
-    };
-#endif
-
-    myMaxVolumes.fill(Midi::MAX_MIDI_CHANNEL_VOLUME);
-    myActiveVolumes.fill(Dynamic::fff);
-
-    // Create all MIDI APIs supported on this platform.
-    std::vector<RtMidi::Api> apis;
-    RtMidi::getCompiledApi(apis);
-
-    for (const RtMidi::Api &api : apis)
-    {
-        try
-        {
-            myMidiOuts.emplace_back(new RtMidiOut(api));
-        }
-        catch (RtMidiError &e)
-        {
-            // Continue anyway, another API might work.
-            e.printMessage();
-        }
-    }
+    resetVolumes();
 }
 
 MidiOutputDevice::~MidiOutputDevice()
@@ -70,78 +34,22 @@ MidiOutputDevice::~MidiOutputDevice()
 void
 MidiOutputDevice::sendMessage(const std::vector<uint8_t> &data)
 {
-    myMidiOut->sendMessage(&data);
+    mySink.sendMessage(data.data(), data.size());
 }
 
 bool MidiOutputDevice::sendMidiMessage(unsigned char a, unsigned char b,
                                        unsigned char c)
 {
-    std::vector<uint8_t> message;
-
-    message.push_back(a);
+    uint8_t message[3] = { a };
+    size_t length = 1;
 
     if (b <= 127)
-        message.push_back(b);
+        message[length++] = b;
 
     if (c <= 127)
-        message.push_back(c);
-
-    try
-    {
-        myMidiOut->sendMessage(&message);
-    }
-    catch (RtMidiError &e)
-    {
-        e.printMessage();
-        return false;
-    }
-
-    return true;
-}
-
-bool MidiOutputDevice::initialize(size_t preferredApi,
-                                  unsigned int preferredPort)
-{
-    if (myMidiOut)
-        myMidiOut->closePort(); // Close any open ports.
-
-    if (preferredApi >= myMidiOuts.size())
-        return false;
-
-    myMidiOut = myMidiOuts[preferredApi].get();
-    unsigned int num_ports = myMidiOut->getPortCount();
+        message[length++] = c;
 
-    if (num_ports == 0)
-        return false;
-
-    try
-    {
-        myMidiOut->openPort(preferredPort);
-    }
-    catch (RtMidiError &e)
-    {
-        e.printMessage();
-        return false;
-    }
-
-    return true;
-}
-
-size_t MidiOutputDevice::getApiCount()
-{
-    return myMidiOuts.size();
-}
-
-unsigned int MidiOutputDevice::getPortCount(size_t api)
-{
-    assert(api < myMidiOuts.size() && "Programming error, api doesn't exist");
-    return myMidiOuts[api]->getPortCount();
-}
-
-std::string MidiOutputDevice::getPortName(size_t api, unsigned int port)
-{
-    assert(api < myMidiOuts.size() && "Programming error, api doesn't exist");
-    return myMidiOuts[api]->getPortName(port);
+    return mySink.sendMessage(message, length);
 }
 
 bool MidiOutputDevice::setPatch(int channel, uint8_t patch)
@@ -238,6 +146,15 @@ bool MidiOutputDevice::setSustain(int channel, bool sustainOn)
     return sendMidiMessage(ControlChange + channel, HoldPedal, value);
 }
 
+void MidiOutputDevice::stopAllNotes()
+{
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        setSustain(channel, false);
+        sendMidiMessage(ControlChange + channel, AllNotesOff, 0);
+    }
+}
+
 void MidiOutputDevice::setPitchBendRange(int channel, uint8_t semiTones)
 {
     sendMidiMessage(ControlChange + channel, RpnMsb, 0);
@@ -257,3 +174,9 @@ void MidiOutputDevice::setChannelMaxVolume(int channel, uint8_t newMaxVolume)
     if (maxVolumeChanged)
         setVolume(channel, myActiveVolumes[channel]);
 }
+
+void MidiOutputDevice::resetVolumes()
+{
+    myMaxVolumes.fill(Midi::MAX_MIDI_CHANNEL_VOLUME);
+    myActiveVolumes.fill(Dynamic::fff);
+}
@@ -27,25 +27,19 @@
 
 #include <array>
 #include <cstdint>
-#include <memory>
-#include <string>
 #include <vector>
 
-class RtMidiOut;
+class MidiSink;
 
+/// Builds MIDI messages and sends them to a MidiSink.
 class MidiOutputDevice
 {
 public:
     static const int NUM_CHANNELS = 16;
 
-    MidiOutputDevice();
+    explicit MidiOutputDevice(MidiSink &sink);
     ~MidiOutputDevice();
 
-    bool initialize(size_t preferredApi, unsigned int preferredPort);
-    size_t getApiCount();
-    unsigned int getPortCount(size_t api);
-    std::string getPortName(size_t api, unsigned int port);
-
     /// Sets the pitch bend range to the given number of semitones.
     void setPitchBendRange(int channel, uint8_t semiTones);
     bool setPatch(int channel, uint8_t patch);
@@ -57,10 +51,15 @@ public:
     bool setVibrato(int channel, uint8_t modulation);
     /// Turns sustain on or off for the specified channel.
     bool setSustain(int channel, bool sustainOn);
+    /// Stops any notes that are playing on all channels.
+    void stopAllNotes();
 
     /// Set the upper limit on a channel's volume. The volume can then be
     /// adjusted within that range by dynamic symbols.
     void setChannelMaxVolume(int channel, uint8_t maxVolume);
+    /// Restores the default volume limits and dynamics for all channels.
+    /// This does not send any messages.
+    void resetVolumes();
 
     enum MidiMessage
     {
@@ -80,7 +79,8 @@ public:
         DataEntryFine = 38,
         HoldPedal = 64,
         RpnLsb = 100,
-        RpnMsb = 101
+        RpnMsb = 101,
+        AllNotesOff = 123
     };
 
     void sendMessage(const std::vector<uint8_t> &data);
@@ -88,8 +88,7 @@ public:
 private:
     bool sendMidiMessage(unsigned char a, unsigned char b, unsigned char c);
 
-    std::vector<std::unique_ptr<RtMidiOut>> myMidiOuts;
-    RtMidiOut *myMidiOut;
+    MidiSink &mySink;
     /// Maximum volume for each channel (as set in the mixer).
     std::array<uint8_t, NUM_CHANNELS> myMaxVolumes;
     /// Volume of last active dynamic for each channel.
@@ -0,0 +1,146 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midioutputservice.h"
+
+#include <app/settingsmanager.h>
+#include <audio/midioutputdevice.h>
+#include <audio/rtmidisink.h>
+#include <audio/settings.h>
+
+MidiOutputService::Lease::Lease(std::unique_lock<std::mutex> lock,
+                                MidiOutputDevice *device)
+    : myLock(std::move(lock)), myDevice(device)
+{
+}
+
+MidiOutputService::Lease::~Lease()
+{
+    // Since the port is left open, make sure that no notes are left ringing
+    // if playback was stopped early.
+    if (myDevice && myLock.owns_lock())
+        myDevice->stopAllNotes();
+}
+
+MidiOutputService::MidiOutputService(SettingsManager &settings_manager)
+    : mySettingsManager(settings_manager),
+      myCustomSink(nullptr),
+      myOpenApi(-1),
+      myOpenPort(-1),
+      myRequestedApi(-1),
+      myRequestedPort(-1)
+{
+    mySettingsConnection =
+        settings_manager.subscribeToChanges([this]() { openInBackground(); });
+}
+
+MidiOutputService::MidiOutputService(SettingsManager &settings_manager,
+                                     MidiSink &sink)
+    : mySettingsManager(settings_manager),
+      myCustomSink(&sink),
+      myDevice(std::make_unique<MidiOutputDevice>(sink)),
+      myOpenApi(-1),
+      myOpenPort(-1),
+      myRequestedApi(-1),
+      myRequestedPort(-1)
+{
+}
+
+MidiOutputService::~MidiOutputService()
+{
+    mySettingsConnection.disconnect();
+
+    std::lock_guard<std::mutex> lock(myRequestMutex);
+    if (myPendingOpen.valid())
+        myPendingOpen.wait();
+}
+
+void MidiOutputService::openInBackground()
+{
+    if (myCustomSink)
+        return;
+
+    int api;
+    int port;
+    {
+        auto settings = mySettingsManager.getReadHandle();
+        api = settings->get(Settings::MidiApi);
+        port = settings->get(Settings::MidiPort);
+    }
+
+    std::lock_guard<std::mutex> lock(myRequestMutex);
+    if (api == myRequestedApi && port == myRequestedPort)
+        return;
+
+    myRequestedApi = api;
+    myRequestedPort = port;
+
+    // Wait for the previous request from the new thread rather than blocking
+    // the caller, so that the requests are handled in order.
+    myPendingOpen = std::async(
+        std::launch::async,
+        [this, previous = std::move(myPendingOpen)]() mutable {
+            if (previous.valid())
+                previous.wait();
+
+            std::lock_guard<std::mutex> lock(myMutex);
+            openPreferredPort();
+        });
+}
+
+MidiOutputService::Lease MidiOutputService::acquire()
+{
+    std::unique_lock<std::mutex> lock(myMutex);
+
+    if (!myCustomSink && !openPreferredPort())
+        return Lease(std::unique_lock<std::mutex>(), nullptr);
+
+    // Don't keep the volumes from the previous playback session.
+    myDevice->resetVolumes();
+
+    return Lease(std::move(lock), myDevice.get());
+}
+
+bool MidiOutputService::openPreferredPort()
+{
+    int api;
+    int port;
+    {
+        auto settings = mySettingsManager.getReadHandle();
+        api = settings->get(Settings::MidiApi);
+        port = settings->get(Settings::MidiPort);
+    }
+
+    if (!myRtMidiSink)
+    {
+        myRtMidiSink = std::make_unique<RtMidiSink>();
+        myDevice = std::make_unique<MidiOutputDevice>(*myRtMidiSink);
+    }
+
+    if (api != myOpenApi || port != myOpenPort)
+    {
+        myOpenApi = myOpenPort = -1;
+
+        if (api < 0 || port < 0 || !myRtMidiSink->initialize(api, port))
+            return false;
+
+        myOpenApi = api;
+        myOpenPort = port;
+    }
+
+    return true;
+}
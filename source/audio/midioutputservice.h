@@ -0,0 +1,105 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUDIO_MIDIOUTPUTSERVICE_H
+#define AUDIO_MIDIOUTPUTSERVICE_H
+
+#include <boost/signals2/connection.hpp>
+#include <future>
+#include <memory>
+#include <mutex>
+
+class MidiOutputDevice;
+class MidiSink;
+class RtMidiSink;
+class SettingsManager;
+
+/// Owns a MIDI output device that is shared by all playback sessions.
+/// Creating the device and opening a port can be slow with some MIDI APIs,
+/// so this is done in the background ahead of time rather than when playback
+/// starts, and the port is only reopened when the preferred API or port
+/// changes.
+class MidiOutputService
+{
+public:
+    /// Provides exclusive access to the device. If the device could not be
+    /// opened, the lease is empty.
+    class Lease
+    {
+    public:
+        Lease(Lease &&other) = default;
+        ~Lease();
+
+        explicit operator bool() const { return myDevice != nullptr; }
+
+        MidiOutputDevice *operator->() const { return myDevice; }
+        MidiOutputDevice &operator*() const { return *myDevice; }
+
+    private:
+        Lease(std::unique_lock<std::mutex> lock, MidiOutputDevice *device);
+
+        friend class MidiOutputService;
+
+        std::unique_lock<std::mutex> myLock;
+        MidiOutputDevice *myDevice;
+    };
+
+    explicit MidiOutputService(SettingsManager &settings_manager);
+    /// Sends all output to the given sink rather than a MIDI port, e.g. to
+    /// record the output of the MIDI player.
+    MidiOutputService(SettingsManager &settings_manager, MidiSink &sink);
+    ~MidiOutputService();
+
+    MidiOutputService(const MidiOutputService &) = delete;
+    MidiOutputService &operator=(const MidiOutputService &) = delete;
+
+    /// Starts opening the preferred port in a background thread, unless it
+    /// has already been requested. This is also done whenever the MIDI API or
+    /// port settings are changed.
+    void openInBackground();
+
+    /// Obtains the device, with the channel volumes reset to their defaults.
+    /// This waits for the port to finish opening in the background (or opens
+    /// it if that hasn't started yet), and blocks if the device is in use by
+    /// another playback session.
+    Lease acquire();
+
+private:
+    /// Opens the preferred port if it is not already open. The mutex must be
+    /// held.
+    bool openPreferredPort();
+
+    SettingsManager &mySettingsManager;
+    std::mutex myMutex;
+    /// The sink provided by the caller, if not using RtMidi.
+    MidiSink *myCustomSink;
+    std::unique_ptr<RtMidiSink> myRtMidiSink;
+    std::unique_ptr<MidiOutputDevice> myDevice;
+    /// The API and port that are currently open, or -1 if no port is open.
+    int myOpenApi;
+    int myOpenPort;
+
+    /// Protects the requested API / port and the pending open.
+    std::mutex myRequestMutex;
+    /// The API and port that were last opened in the background.
+    int myRequestedApi;
+    int myRequestedPort;
+    std::future<void> myPendingOpen;
+    boost::signals2::scoped_connection mySettingsConnection;
+};
+
+#endif
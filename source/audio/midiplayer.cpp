@@ -19,14 +19,21 @@
 
 #include <app/settingsmanager.h>
 #include <audio/midioutputdevice.h>
+#include <audio/midioutputservice.h>
+#include <algorithm>
 #include <audio/settings.h>
 #include <boost/rational.hpp>
 #include <cassert>
 #include <chrono>
+#include <limits>
+#include <memory>
 #include <midi/midifile.h>
+#include <midi/midiloopbuffer.h>
+#include <midi/midiseekindex.h>
 #include <score/generalmidi.h>
 #include <score/score.h>
 #include <thread>
+#include <util/tracing.h>
 
 #ifdef _WIN32
 #include <boost/scope_exit.hpp>
@@ -38,12 +45,16 @@ static const int METRONOME_CHANNEL = 9;
 using DurationType = std::chrono::duration<int, std::micro>;
 
 MidiPlayer::MidiPlayer(SettingsManager &settings_manager,
+                       MidiOutputService &output_service,
                        const ScoreLocation &start_location, int speed)
     : mySettingsManager(settings_manager),
+      myOutputService(output_service),
+      myMetronomeEnabled(settings_manager, Settings::MetronomeEnabled),
       myScore(start_location.getScore()),
       myStartLocation(start_location),
       myIsPlaying(false),
-      myPlaybackSpeed(speed)
+      myPlaybackSpeed(speed),
+      myLoopRegionChanged(false)
 {
 }
 
@@ -64,12 +75,7 @@ void MidiPlayer::run()
     } BOOST_SCOPE_EXIT_END
 #endif
 
-    boost::signals2::scoped_connection connection(
-        mySettingsManager.subscribeToChanges([&]() {
-            auto settings = mySettingsManager.getReadHandle();
-            myMetronomeEnabled = settings->get(Settings::MetronomeEnabled);
-        }));
-
+    Tracing::setThreadName("MIDI playback");
     setIsPlaying(true);
 
     MidiFile::LoadOptions options;
@@ -77,14 +83,8 @@ void MidiPlayer::run()
     options.myRecordPositionChanges = true;
 
     // Load MIDI settings.
-    int api;
-    int port;
     {
         auto settings = mySettingsManager.getReadHandle();
-        myMetronomeEnabled = settings->get(Settings::MetronomeEnabled);
-
-        api = settings->get(Settings::MidiApi);
-        port = settings->get(Settings::MidiPort);
 
         options.myMetronomePreset = settings->get(Settings::MetronomePreset) +
                                     Midi::MIDI_PERCUSSION_PRESET_OFFSET;
@@ -111,17 +111,29 @@ void MidiPlayer::run()
 
     // TODO - since each track is already sorted, an n-way merge should be
     // faster.
-    std::stable_sort(events.begin(), events.end());
-    events.convertToDeltaTicks();
+    {
+        Tracing::Span span("MidiPlayer sort events");
+        std::stable_sort(events.begin(), events.end());
+    }
 
-    // Initialize RtMidi and set the port.
-    MidiOutputDevice device;
-    if (!device.initialize(api, port))
+    const MidiSeekIndex seek_index(events, file.getBarStarts());
+
+    // Obtain the shared output device, which waits for the port to be opened.
+    MidiOutputService::Lease device = myOutputService.acquire();
+    if (!device)
     {
         emit error(tr("Error initializing MIDI output device."));
         return;
     }
 
+    int speed_increment;
+    int speed_limit;
+    {
+        auto settings = mySettingsManager.getReadHandle();
+        speed_increment = settings->get(Settings::LoopSpeedIncrement);
+        speed_limit = settings->get(Settings::LoopSpeedLimit);
+    }
+
     bool started = false;
     int beat_duration = Midi::BEAT_DURATION_120_BPM;
     const SystemLocation start_location(myStartLocation.getSystemIndex(),
@@ -130,39 +142,13 @@ void MidiPlayer::run()
 
     DurationType clock_drift(0);
 
-    for (auto event = events.begin(); event != events.end(); ++event)
-    {
-        if (!isPlaying())
-            break;
-
-        if (event->isTempoChange())
-            beat_duration = event->getTempo();
-
-        // Skip events before the start location, except for events such as
-        // instrument changes. Tempo changes are tracked above.
-        if (!started)
-        {
-            if (event->getLocation() < start_location)
-            {
-                if (event->isProgramChange())
-                    device.sendMessage(event->getData());
-
-                continue;
-            }
-            else
-            {
-                performCountIn(device, event->getLocation(), beat_duration);
-
-                started = true;
-            }
-        }
-
-        auto start_timestamp = std::chrono::high_resolution_clock::now();
-
-        const int delta = event->getTicks();
+    // Waits until the event is due and then sends it, or just waits if there
+    // is no event.
+    auto play_event = [&](const MidiEvent *event, int delta) {
         assert(delta >= 0);
+        auto start_timestamp = std::chrono::high_resolution_clock::now();
 
-		// Compute the time in microseconds that we should sleep for, and then
+        // Compute the time in microseconds that we should sleep for, and then
         // adjust for accumulated timing errors (since sleep_for() is not
         // perfectly precise).
         auto sleep_duration = DurationType(
@@ -178,32 +164,37 @@ void MidiPlayer::run()
         if (sleep_duration.count() != 0)
             std::this_thread::sleep_for(sleep_duration);
 
-        // Don't play metronome events if the metronome is disabled.
-        // Tempo change events also don't need to be sent since they are
-        // handled in this loop. CoreMidi on OSX also complains about them.
-        if (!(event->isNoteOnOff() &&
-              event->getChannel() == METRONOME_CHANNEL &&
-              !myMetronomeEnabled) &&
-            !event->isTempoChange())
+        if (event)
         {
-            device.sendMessage(event->getData());
-        }
+            if (event->isTempoChange())
+                beat_duration = event->getTempo();
+
+            // Don't play metronome events if the metronome is disabled.
+            // Tempo change events also don't need to be sent since they are
+            // handled in this loop. CoreMidi on OSX also complains about them.
+            if (!(event->isNoteOnOff() &&
+                  event->getChannel() == METRONOME_CHANNEL &&
+                  !myMetronomeEnabled) &&
+                !event->isTempoChange())
+            {
+                device->sendMessage(event->getData());
+            }
 
-        // Notify listeners of the current playback position.
-        if (event->getLocation() != current_location)
-        {
+            // Notify listeners of the current playback position.
             const SystemLocation &new_location = event->getLocation();
 
             // Don't move backwards unless a repeat occurred.
-            if (new_location < current_location && !event->isPositionChange())
-                continue;
-
-            if (new_location.getSystem() != current_location.getSystem())
-                emit playbackSystemChanged(new_location.getSystem());
+            if (new_location != current_location &&
+                (!(new_location < current_location) ||
+                 event->isPositionChange()))
+            {
+                if (new_location.getSystem() != current_location.getSystem())
+                    emit playbackSystemChanged(new_location.getSystem());
 
-            emit playbackPositionChanged(new_location.getPosition());
+                emit playbackPositionChanged(new_location.getPosition());
 
-            current_location = new_location;
+                current_location = new_location;
+            }
         }
 
         // Accumulate any difference between the desired delta time and what
@@ -212,6 +203,177 @@ void MidiPlayer::run()
         auto actual_duration = std::chrono::duration_cast<DurationType>(
             end_timestamp - start_timestamp);
         clock_drift += actual_duration - sleep_duration;
+    };
+
+    // Rebuild the loop if the region was changed. This only copies the events
+    // for the region, so it is cheap enough to do between two events.
+    std::optional<MidiLoopBuffer> loop;
+    auto update_loop = [&]() {
+        if (!myLoopRegionChanged.exchange(false))
+            return;
+
+        std::optional<LoopRegion> region;
+        {
+            std::lock_guard<std::mutex> lock(myLoopMutex);
+            region = myLoopRegion;
+        }
+
+        Tracing::Span span("MidiPlayer update loop");
+
+        loop.reset();
+        if (region)
+        {
+            loop = MidiLoopBuffer::create(events, seek_index, region->myStart,
+                                          region->myEnd);
+        }
+    };
+
+    // Repeats the loop until looping is disabled or playback is stopped, and
+    // returns the tick where the last repetition ended.
+    auto play_loop = [&]() {
+        int end_tick = loop->getEndTick();
+
+        while (loop && isPlaying())
+        {
+            Tracing::Span span("MidiPlayer play loop");
+
+            // Silence any notes that are still ringing, and restore the
+            // instruments, volume, etc from the start of the loop.
+            device->stopAllNotes();
+            for (const MidiEvent &restore_event : loop->getRestoreEvents())
+                device->sendMessage(restore_event.getData());
+
+            beat_duration = loop->getTempo();
+
+            const SystemLocation &loop_start = loop->getStartLocation();
+            if (loop_start.getSystem() != current_location.getSystem())
+                emit playbackSystemChanged(loop_start.getSystem());
+            emit playbackPositionChanged(loop_start.getPosition());
+            current_location = loop_start;
+
+            int loop_tick = 0;
+            for (const MidiEvent &loop_event : loop->getEvents())
+            {
+                if (!isPlaying())
+                    break;
+
+                play_event(&loop_event, loop_event.getTicks() - loop_tick);
+                loop_tick = loop_event.getTicks();
+            }
+
+            if (!isPlaying())
+                break;
+
+            // Wait until the end of the last bar, so that the next repetition
+            // starts exactly on time.
+            play_event(nullptr, loop->getLength() - loop_tick);
+            end_tick = loop->getEndTick();
+
+            // Speed up for the next repetition, if requested.
+            if (speed_increment > 0 && myPlaybackSpeed < speed_limit)
+            {
+                const int speed =
+                    std::min(myPlaybackSpeed + speed_increment, speed_limit);
+                changePlaybackSpeed(speed);
+                emit playbackSpeedChanged(speed);
+            }
+
+            update_loop();
+        }
+
+        return end_tick;
+    };
+
+    // Trace the playback of each bar rather than each event, so that spans
+    // are rarely recorded from this thread.
+    const std::vector<MidiFile::BarStart> &bar_starts = file.getBarStarts();
+    std::unique_ptr<Tracing::Span> bar_span;
+    int bar_end_tick = -1;
+    auto trace_bar = [&](int tick) {
+        if (tick < bar_end_tick)
+            return;
+
+        bar_span.reset();
+        if (!Tracing::isEnabled())
+            return;
+
+        bar_span = std::make_unique<Tracing::Span>("MidiPlayer play bar");
+
+        auto next_bar = std::upper_bound(
+            bar_starts.begin(), bar_starts.end(), tick,
+            [](int t, const MidiFile::BarStart &bar) { return t < bar.myTick; });
+        bar_end_tick = (next_bar != bar_starts.end())
+                           ? next_bar->myTick
+                           : std::numeric_limits<int>::max();
+    };
+
+    // Jump straight to the bar containing the start location, and restore the
+    // state of each channel (instruments, volume, etc) at the start of that
+    // bar.
+    auto event = events.begin();
+    int current_tick = 0;
+    if (const MidiSeekIndex::Entry *entry = seek_index.find(start_location))
+    {
+        beat_duration = entry->myTempo;
+
+        for (const MidiEvent &restore_event :
+             MidiSeekIndex::getRestoreEvents(*entry))
+        {
+            device->sendMessage(restore_event.getData());
+        }
+
+        event += entry->myEventIndex;
+        current_tick = entry->myBar.myTick;
+    }
+
+    while (event != events.end() && isPlaying())
+    {
+        // Skip notes before the start location, but send events such as
+        // instrument or controller changes.
+        if (!started)
+        {
+            if (event->getLocation() < start_location)
+            {
+                if (event->isTempoChange())
+                    beat_duration = event->getTempo();
+                else if (event->isChannelMessage() && !event->isNoteOnOff())
+                    device->sendMessage(event->getData());
+
+                current_tick = event->getTicks();
+                ++event;
+                continue;
+            }
+            else
+            {
+                performCountIn(*device, event->getLocation(), beat_duration);
+
+                started = true;
+            }
+        }
+
+        update_loop();
+
+        if (loop && event->getTicks() >= loop->getEndTick())
+        {
+            // Finish the last bar before returning to the start of the loop.
+            if (current_tick < loop->getEndTick())
+                play_event(nullptr, loop->getEndTick() - current_tick);
+
+            bar_span.reset();
+            bar_end_tick = -1;
+            current_tick = play_loop();
+
+            // Looping was disabled, so continue from the end of the region.
+            event = std::lower_bound(
+                events.begin(), events.end(), current_tick,
+                [](const MidiEvent &e, int tick) { return e.getTicks() < tick; });
+            continue;
+        }
+
+        trace_bar(event->getTicks());
+        play_event(&*event, event->getTicks() - current_tick);
+        current_tick = event->getTicks();
+        ++event;
     }
 }
 
@@ -264,6 +426,16 @@ void MidiPlayer::performCountIn(MidiOutputDevice &device,
     }
 }
 
+void MidiPlayer::setLoopRegion(const std::optional<LoopRegion> &region)
+{
+    {
+        std::lock_guard<std::mutex> lock(myLoopMutex);
+        myLoopRegion = region;
+    }
+
+    myLoopRegionChanged = true;
+}
+
 void MidiPlayer::changePlaybackSpeed(int new_speed)
 {
     myPlaybackSpeed = new_speed;
@@ -18,15 +18,18 @@
 #ifndef AUDIO_MIDIPLAYER_H
 #define AUDIO_MIDIPLAYER_H
 
+#include <app/settingsmanager.h>
 #include <atomic>
+#include <mutex>
+#include <optional>
 #include <QThread>
 #include <score/scorelocation.h>
+#include <score/systemlocation.h>
 
 class MidiFile;
 class MidiOutputDevice;
+class MidiOutputService;
 class Score;
-class SettingsManager;
-class SystemLocation;
 
 class MidiPlayer : public QThread
 {
@@ -34,9 +37,25 @@ class MidiPlayer : public QThread
 
 public:
     MidiPlayer(SettingsManager &settings_manager,
+               MidiOutputService &output_service,
                const ScoreLocation &start_location, int speed);
     ~MidiPlayer();
 
+    /// A range of bars to repeat, given by a location in the first and last
+    /// bars.
+    struct LoopRegion
+    {
+        SystemLocation myStart;
+        SystemLocation myEnd;
+    };
+
+    /// Repeats the region during playback, or stops looping if no region is
+    /// given. The loop is played from a copy of its events, so the region can
+    /// be changed during playback without regenerating the MIDI file. When
+    /// already looping, the new region takes effect at the end of the current
+    /// repetition.
+    void setLoopRegion(const std::optional<LoopRegion> &region);
+
     void changePlaybackSpeed(int new_speed);
 
     const ScoreLocation &getStartLocation() const { return myStartLocation; }
@@ -46,6 +65,8 @@ signals:
     // necessary
     void playbackSystemChanged(int system);
     void playbackPositionChanged(int position);
+    /// Emitted when the playback speed is increased after a loop repetition.
+    void playbackSpeedChanged(int speed);
     void error(const QString &msg);
 
 private:
@@ -58,12 +79,21 @@ private:
     bool isPlaying() const;
 
     SettingsManager &mySettingsManager;
+    MidiOutputService &myOutputService;
+    /// Checked for each metronome event, so that the metronome can be toggled
+    /// during playback.
+    CachedSetting<bool> myMetronomeEnabled;
     const Score &myScore;
     ScoreLocation myStartLocation;
     std::atomic<bool> myIsPlaying;
-    std::atomic<bool> myMetronomeEnabled;
     /// The current playback speed (percent).
     std::atomic<int> myPlaybackSpeed;
+
+    std::mutex myLoopMutex;
+    std::optional<LoopRegion> myLoopRegion;
+    /// Set when the loop region is modified, so that the playback thread only
+    /// needs to lock the mutex when there is a change.
+    std::atomic<bool> myLoopRegionChanged;
 };
 
 #endif
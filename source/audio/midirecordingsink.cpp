@@ -0,0 +1,64 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midirecordingsink.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+MidiRecordingSink::MidiRecordingSink(size_t capacity)
+    : myMessages(capacity), myTotalCount(0), myStartTime(Clock::now())
+{
+    if (capacity == 0)
+        throw std::invalid_argument("The capacity must be non-zero");
+}
+
+bool MidiRecordingSink::sendMessage(const uint8_t *data, size_t length)
+{
+    Message &message = myMessages[myTotalCount % myMessages.size()];
+    ++myTotalCount;
+
+    message.myTimestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - myStartTime);
+    message.myLength = std::min(length, MAX_MESSAGE_SIZE);
+    std::copy(data, data + message.myLength, message.myData.begin());
+
+    return true;
+}
+
+size_t MidiRecordingSink::getMessageCount() const
+{
+    return std::min(myTotalCount, myMessages.size());
+}
+
+const MidiRecordingSink::Message &MidiRecordingSink::getMessage(size_t i) const
+{
+    assert(i < getMessageCount());
+
+    // If the buffer has wrapped around, the oldest message is the one that
+    // will be overwritten next.
+    const size_t first =
+        myTotalCount > myMessages.size() ? myTotalCount % myMessages.size() : 0;
+    return myMessages[(first + i) % myMessages.size()];
+}
+
+void MidiRecordingSink::clear()
+{
+    myTotalCount = 0;
+    myStartTime = Clock::now();
+}
@@ -0,0 +1,72 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUDIO_MIDIRECORDINGSINK_H
+#define AUDIO_MIDIRECORDINGSINK_H
+
+#include "midisink.h"
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+/// Records MIDI messages along with the time they were sent, rather than
+/// playing them. This allows the output of the MIDI player to be inspected
+/// without a MIDI device (e.g. in tests).
+/// Messages are stored in a ring buffer that is allocated up front, so once
+/// the buffer is full the oldest messages are overwritten.
+/// The recorded messages must not be read while messages are being sent.
+class MidiRecordingSink : public MidiSink
+{
+public:
+    /// Longer messages (e.g. meta events) are truncated.
+    static constexpr size_t MAX_MESSAGE_SIZE = 8;
+
+    struct Message
+    {
+        /// Time since the sink was created or last cleared.
+        std::chrono::microseconds myTimestamp;
+        /// The number of bytes that were stored in myData.
+        size_t myLength;
+        std::array<uint8_t, MAX_MESSAGE_SIZE> myData;
+    };
+
+    explicit MidiRecordingSink(size_t capacity);
+
+    bool sendMessage(const uint8_t *data, size_t length) override;
+
+    /// Returns the number of recorded messages that are available.
+    size_t getMessageCount() const;
+    /// Returns the total number of messages sent, including any that have
+    /// since been overwritten.
+    size_t getTotalMessageCount() const { return myTotalCount; }
+
+    /// Returns a recorded message, where 0 is the oldest available message.
+    const Message &getMessage(size_t i) const;
+
+    /// Removes all recorded messages and restarts the clock.
+    void clear();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    std::vector<Message> myMessages;
+    size_t myTotalCount;
+    Clock::time_point myStartTime;
+};
+
+#endif
@@ -0,0 +1,35 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUDIO_MIDISINK_H
+#define AUDIO_MIDISINK_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// Destination for the MIDI messages produced by a MidiOutputDevice, such as
+/// a hardware / software synth or a recording for tests.
+class MidiSink
+{
+public:
+    virtual ~MidiSink() {}
+
+    /// Sends a single MIDI message, returning false if it could not be sent.
+    virtual bool sendMessage(const uint8_t *data, size_t length) = 0;
+};
+
+#endif
@@ -0,0 +1,51 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUDIO_RTMIDISINK_H
+#define AUDIO_RTMIDISINK_H
+
+#include "midisink.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class RtMidiOut;
+
+/// Sends MIDI messages to an output port using RtMidi.
+class RtMidiSink : public MidiSink
+{
+public:
+    RtMidiSink();
+    ~RtMidiSink();
+
+    /// Opens the specified port, closing any previously opened port.
+    bool initialize(size_t preferredApi, unsigned int preferredPort);
+    size_t getApiCount();
+    unsigned int getPortCount(size_t api);
+    std::string getPortName(size_t api, unsigned int port);
+
+    bool sendMessage(const uint8_t *data, size_t length) override;
+
+private:
+    std::vector<std::unique_ptr<RtMidiOut>> myMidiOuts;
+    RtMidiOut *myMidiOut;
+    /// Reused for each message, since RtMidi requires a std::vector.
+    std::vector<unsigned char> myBuffer;
+};
+
+#endif
@@ -44,4 +44,8 @@ const Setting<int> CountInPreset("midi/count_in_preset",
                                  Midi::MIDI_PERCUSSION_PRESET_RIDE_CYMBAL2);
 
 const Setting<int> CountInVolume("midi/count_in_volume", 127);
+
+const Setting<int> LoopSpeedIncrement("midi/loop_speed_increment", 0);
+
+const Setting<int> LoopSpeedLimit("midi/loop_speed_limit", 100);
 }
@@ -37,6 +37,9 @@ namespace Settings
     extern const Setting<bool> CountInEnabled;
     extern const Setting<int> CountInPreset;
     extern const Setting<int> CountInVolume;
+
+    extern const Setting<int> LoopSpeedIncrement;
+    extern const Setting<int> LoopSpeedLimit;
 }
 
 #endif
@@ -20,16 +20,22 @@
 #include <app/powertabeditor.h>
 #include <app/settings.h>
 #include <app/settingsmanager.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/program_options.hpp>
+#include <chrono>
 #include <csignal>
 #include <dialogs/crashdialog.h>
 #include <exception>
 #include <iostream>
+#include <optional>
 #include <QApplication>
 #include <QFileOpenEvent>
 #include <QLocalServer>
 #include <QLocalSocket>
+#include <QTimer>
 #include <string>
+#include <util/tracing.h>
 
 #ifdef __APPLE__
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED
@@ -69,6 +75,21 @@ static void displayError(const std::string &reason)
     std::exit(EXIT_FAILURE);
 }
 
+static void writeTrace(const boost::filesystem::path &path)
+{
+    if (path.has_parent_path())
+        boost::filesystem::create_directories(path.parent_path());
+
+    boost::filesystem::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Error writing trace to " << path << std::endl;
+        return;
+    }
+
+    Tracing::writeChromeTrace(file);
+}
+
 static void terminateHandler()
 {
     std::string message;
@@ -130,6 +151,8 @@ protected:
 
 int main(int argc, char *argv[])
 {
+    const auto startTime = std::chrono::steady_clock::now();
+
     // Register handlers for unhandled exceptions and segmentation faults.
     std::set_terminate(terminateHandler);
     std::signal(SIGSEGV, signalHandler);
@@ -148,6 +171,8 @@ int main(int argc, char *argv[])
 #endif
 
     QStringList filesToOpen;
+    std::optional<boost::filesystem::path> tracePath;
+    bool startupBenchmark = false;
 
     namespace po = boost::program_options;
     po::options_description desc("Usage: powertabeditor [options] [files...] "
@@ -157,6 +182,12 @@ int main(int argc, char *argv[])
         desc.add_options()
             ("help,h", "Displays this help.")
             ("version,v", "Displays version information.")
+            ("trace", po::value<std::string>(),
+             "Records a performance trace (in the Chrome trace format) and "
+             "writes it to the given file on exit.")
+            ("startup-benchmark",
+             "Reports the time taken to show the window and open any files, "
+             "and then exits.")
             ("files", po::value<std::vector<std::string>>(),
              "The files to be opened, optionally.");
         po::positional_options_description p;
@@ -190,6 +221,11 @@ int main(int argc, char *argv[])
             for (auto &file : files)
                 filesToOpen.push_back(QString::fromStdString(file));
         }
+
+        if (vm.count("trace"))
+            tracePath = vm["trace"].as<std::string>();
+
+        startupBenchmark = vm.count("startup-benchmark") > 0;
     }
     catch(po::error &e)
     {
@@ -205,6 +241,9 @@ int main(int argc, char *argv[])
         auto settings = settings_manager.getReadHandle();
         bool single_window_mode = !settings->get(Settings::OpenFilesInNewWindow);
 
+        if (!tracePath && settings->get(Settings::RecordTrace))
+            tracePath = Paths::getUserDataDir() / "trace.json";
+
         // If an instance of the program is already running and we're in
         // single-window mode, tell the running instance to open the files in
         // new tabs.
@@ -224,6 +263,12 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (tracePath)
+    {
+        Tracing::enable();
+        Tracing::setThreadName("Main");
+    }
+
     // Otherwise, launch a new window.
     PowerTabEditor program;
 
@@ -249,9 +294,32 @@ int main(int argc, char *argv[])
 
     server.listen(QCoreApplication::applicationFilePath());
 
-    // Launch the application.
+    if (startupBenchmark)
+    {
+        auto report = [=](const char *label) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - startTime);
+            std::cout << label << ": " << elapsed.count() << "ms" << std::endl;
+        };
+
+        QObject::connect(&program, &PowerTabEditor::firstPaintFinished,
+                         [=]() { report("Time to first paint"); });
+        QObject::connect(&program, &PowerTabEditor::startupFinished, [=]() {
+            report("Time to open files");
+            QTimer::singleShot(0, &QCoreApplication::quit);
+        });
+    }
+
+    // Launch the application. Any files are opened once the event loop has
+    // started, after the window has been drawn.
     program.show();
-    program.openFiles(filesToOpen);
+    // Don't let the benchmark wait for the user to answer the recovery prompt.
+    program.finishStartup(filesToOpen, !startupBenchmark);
+
+    const int result = a.exec();
+
+    if (tracePath)
+        writeTrace(*tracePath);
 
-    return a.exec();
+    return result;
 }
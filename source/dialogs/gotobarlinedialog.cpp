@@ -19,33 +19,23 @@
 #include "ui_gotobarlinedialog.h"
 
 #include <score/score.h>
+#include <score/utils/barindex.h>
 
-GoToBarlineDialog::GoToBarlineDialog(QWidget *parent, const Score &score)
+GoToBarlineDialog::GoToBarlineDialog(QWidget *parent, const Score &score,
+                                     const BarIndex &barIndex)
     : QDialog(parent),
-      ui(new Ui::GoToBarlineDialog)
+      ui(new Ui::GoToBarlineDialog),
+      myScore(score),
+      myBarIndex(barIndex)
 {
     ui->setupUi(this);
 
     connect(ui->buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
     connect(ui->buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
 
-    for (int system_index = 0;
-         system_index < static_cast<int>(score.getSystems().size());
-         ++system_index)
-    {
-        const System &system = score.getSystems()[system_index];
-        // Index all barlines except for the end bar.
-        for (int i = 0; i < static_cast<int>(system.getBarlines().size()) - 1;
-             ++i)
-        {
-            myLocations.push_back(ScoreLocation(
-                score, system_index, 0, system.getBarlines()[i].getPosition()));
-        }
-    }
-
     ui->barlineSpinBox->setValue(1);
     ui->barlineSpinBox->setMinimum(1);
-    ui->barlineSpinBox->setMaximum(static_cast<int>(myLocations.size()));
+    ui->barlineSpinBox->setMaximum(barIndex.getBarCount());
 
     ui->barlineSpinBox->selectAll();
 }
@@ -58,6 +48,7 @@ GoToBarlineDialog::~GoToBarlineDialog()
 /// Returns the location of the selected barline.
 ScoreLocation GoToBarlineDialog::getLocation() const
 {
-    const int index = ui->barlineSpinBox->value();
-    return myLocations.at(index - 1);
+    const BarIndex::Bar bar =
+        myBarIndex.getBar(ui->barlineSpinBox->value() - 1);
+    return ScoreLocation(myScore, bar.mySystem, 0, bar.myStartPosition);
 }
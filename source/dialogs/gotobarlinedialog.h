@@ -20,18 +20,19 @@
 
 #include <QDialog>
 #include <score/scorelocation.h>
-#include <vector>
 
 namespace Ui {
 class GoToBarlineDialog;
 }
 
+class BarIndex;
 class Score;
 
 class GoToBarlineDialog : public QDialog
 {
 public:
-    explicit GoToBarlineDialog(QWidget *parent, const Score &score);
+    explicit GoToBarlineDialog(QWidget *parent, const Score &score,
+                               const BarIndex &barIndex);
     ~GoToBarlineDialog();
 
     /// Returns the location of the selected barline.
@@ -39,7 +40,8 @@ public:
 
 private:
     Ui::GoToBarlineDialog *ui;
-    std::vector<ScoreLocation> myLocations;
+    const Score &myScore;
+    const BarIndex &myBarIndex;
 };
 
 #endif
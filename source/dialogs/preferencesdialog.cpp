@@ -20,9 +20,10 @@
 
 #include <app/settings.h>
 #include <app/settingsmanager.h>
-#include <audio/midioutputdevice.h>
+#include <audio/rtmidisink.h>
 #include <audio/settings.h>
 #include <dialogs/tuningdialog.h>
+#include <formats/settings.h>
 #include <score/generalmidi.h>
 #include <util/tostring.h>
 
@@ -43,7 +44,7 @@ PreferencesDialog::PreferencesDialog(QWidget *parent,
     connect(ui->buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
 
     // Add available MIDI ports.
-    MidiOutputDevice device;
+    RtMidiSink device;
     for (size_t i = 0; i < device.getApiCount(); ++i)
     {
         for(unsigned int j = 0; j < device.getPortCount(i); ++j)
@@ -73,6 +74,17 @@ PreferencesDialog::PreferencesDialog(QWidget *parent,
 
     ui->countInVolumeSpinBox->setRange(0, 127);
 
+    ui->loopSpeedIncrementSpinBox->setRange(0, 25);
+    ui->loopSpeedIncrementSpinBox->setSuffix(QStringLiteral("%"));
+    ui->loopSpeedLimitSpinBox->setRange(50, 125);
+    ui->loopSpeedLimitSpinBox->setSuffix(QStringLiteral("%"));
+
+    ui->compressionLevelSpinBox->setRange(0, 9);
+#ifndef PTE_ENABLE_ZSTD
+    ui->zstdCompressionLabel->hide();
+    ui->zstdCompressionCheckBox->hide();
+#endif
+
     loadCurrentSettings();
 }
 
@@ -89,7 +101,7 @@ void PreferencesDialog::loadCurrentSettings()
     const unsigned int port = settings->get(Settings::MidiPort);
 
     // Find the preferred midi port in the combo box.
-    MidiOutputDevice device;
+    RtMidiSink device;
     if (api < device.getApiCount() && port < device.getPortCount(api))
     {
         ui->midiPortComboBox->setCurrentIndex(ui->midiPortComboBox->findText(
@@ -122,9 +134,23 @@ void PreferencesDialog::loadCurrentSettings()
 
     ui->countInVolumeSpinBox->setValue(settings->get(Settings::CountInVolume));
 
+    ui->loopSpeedIncrementSpinBox->setValue(
+        settings->get(Settings::LoopSpeedIncrement));
+
+    ui->loopSpeedLimitSpinBox->setValue(
+        settings->get(Settings::LoopSpeedLimit));
+
     ui->openInNewWindowCheckBox->setChecked(
         settings->get(Settings::OpenFilesInNewWindow));
 
+    ui->compressionLevelSpinBox->setValue(
+        settings->get(Settings::PowerTabCompressionLevel));
+
+    ui->zstdCompressionCheckBox->setChecked(
+        settings->get(Settings::PowerTabZstdCompression));
+
+    ui->recordTraceCheckBox->setChecked(settings->get(Settings::RecordTrace));
+
     ui->defaultInstrumentNameLineEdit->setText(
         QString::fromStdString(settings->get(Settings::DefaultInstrumentName)));
     ui->defaultPresetComboBox->setCurrentIndex(
@@ -174,9 +200,23 @@ void PreferencesDialog::accept()
 
     settings->set(Settings::CountInVolume, ui->countInVolumeSpinBox->value());
 
+    settings->set(Settings::LoopSpeedIncrement,
+                  ui->loopSpeedIncrementSpinBox->value());
+
+    settings->set(Settings::LoopSpeedLimit,
+                  ui->loopSpeedLimitSpinBox->value());
+
     settings->set(Settings::OpenFilesInNewWindow,
                   ui->openInNewWindowCheckBox->isChecked());
 
+    settings->set(Settings::PowerTabCompressionLevel,
+                  ui->compressionLevelSpinBox->value());
+
+    settings->set(Settings::PowerTabZstdCompression,
+                  ui->zstdCompressionCheckBox->isChecked());
+
+    settings->set(Settings::RecordTrace, ui->recordTraceCheckBox->isChecked());
+
     settings->set(Settings::DefaultInstrumentName,
                   ui->defaultInstrumentNameLineEdit->text().toStdString());
 
@@ -56,9 +56,11 @@ public:
     virtual ~FileFormatImporter();
 
     /// Imports the file into the given score.
+    /// Importers do not keep any state between calls, so this may be called
+    /// concurrently from several threads.
     /// @throw FileFormatException
     virtual void load(const boost::filesystem::path &filename,
-                      Score &score) = 0;
+                      Score &score) const = 0;
 
     /// Returns the file format corresponding to this importer.
     FileFormat fileFormat() const;
@@ -75,9 +77,11 @@ public:
     virtual ~FileFormatExporter();
 
     /// Exports the given score to a file.
+    /// Exporters do not keep any state between calls, so this may be called
+    /// from a background thread.
     /// @throw FileFormatException
     virtual void save(const boost::filesystem::path &filename,
-                      const Score &score) = 0;
+                      const Score &score) const = 0;
 
     /// Returns the file format corresponding to this exporter.
     FileFormat fileFormat() const;
@@ -17,6 +17,7 @@
   
 #include "fileformatmanager.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <formats/gpx/gpximporter.h>
 #include <formats/guitar_pro/guitarproimporter.h>
 #include <formats/midi/midiexporter.h>
@@ -24,6 +25,33 @@
 #include <formats/powertab/powertabexporter.h>
 #include <formats/powertab_old/powertaboldimporter.h>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/// Flushes the file's contents from the operating system's cache to the disk.
+static void syncToDisk(const boost::filesystem::path &path)
+{
+#ifdef _WIN32
+    const int fd = _wopen(path.c_str(), _O_RDWR | _O_BINARY);
+    const bool success = fd >= 0 && _commit(fd) == 0;
+    if (fd >= 0)
+        _close(fd);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    const bool success = fd >= 0 && ::fsync(fd) == 0;
+    if (fd >= 0)
+        ::close(fd);
+#endif
+
+    if (!success)
+        throw FileFormatException("Error writing to " + path.string());
+}
+
 FileFormatManager::FileFormatManager(const SettingsManager &settings_manager)
 {
     myImporters.emplace_back(new PowerTabImporter());
@@ -31,7 +59,7 @@ FileFormatManager::FileFormatManager(const SettingsManager &settings_manager)
     myImporters.emplace_back(new GuitarProImporter());
     myImporters.emplace_back(new GpxImporter());
 
-    myExporters.emplace_back(new PowerTabExporter());
+    myExporters.emplace_back(new PowerTabExporter(settings_manager));
     myExporters.emplace_back(new MidiExporter(settings_manager));
 }
 
@@ -75,7 +103,7 @@ std::string FileFormatManager::importFileFilter() const
 
 void FileFormatManager::importFile(Score &score,
                                    const boost::filesystem::path &filename,
-                                   const FileFormat &format)
+                                   const FileFormat &format) const
 {
     for (auto &importer : myImporters)
     {
@@ -106,13 +134,44 @@ std::string FileFormatManager::exportFileFilter() const
 
 void FileFormatManager::exportFile(const Score &score,
                                    const boost::filesystem::path &filename,
-                                   const FileFormat &format)
+                                   const FileFormat &format) const
 {
+    namespace fs = boost::filesystem;
+
     for (auto &exporter : myExporters)
     {
         if (exporter->fileFormat() == format)
         {
-            exporter->save(filename, score);
+            // Write to a temporary file in the same directory and then replace
+            // the original, so that an existing file is never left
+            // half-written if saving fails or the program crashes.
+            const fs::path temp_path = fs::unique_path(
+                filename.parent_path() /
+                (filename.filename().string() + ".%%%%-%%%%.tmp"));
+
+            try
+            {
+                exporter->save(temp_path, score);
+                // Otherwise, a crash shortly after the rename could leave an
+                // empty or truncated file in place of the original.
+                syncToDisk(temp_path);
+
+                // Keep the permissions of the file being replaced, rather
+                // than using the defaults for a new file.
+                boost::system::error_code ec;
+                const fs::file_status status = fs::status(filename, ec);
+                if (!ec && fs::exists(status))
+                    fs::permissions(temp_path, status.permissions());
+
+                fs::rename(temp_path, filename);
+            }
+            catch (...)
+            {
+                boost::system::error_code ec;
+                fs::remove(temp_path, ec);
+                throw;
+            }
+
             return;
         }
     }
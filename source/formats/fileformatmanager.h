@@ -43,17 +43,20 @@ public:
     std::string importFileFilter() const;
 
     /// Imports a file into the given score.
+    /// This is safe to call concurrently for different scores.
     /// @throws std::exception
     void importFile(Score &score, const boost::filesystem::path &filename,
-                    const FileFormat &format);
+                    const FileFormat &format) const;
 
     /// Returns a correctly formatted file filter for a Qt file dialog.
     std::string exportFileFilter() const;
 
-    /// Exports the given score to a file.
+    /// Exports the given score to a file. The file is written atomically, so
+    /// the previous contents are kept if an error occurs.
+    /// This is safe to call from a background thread.
     /// @throws std::exception
     void exportFile(const Score &score, const boost::filesystem::path &filename,
-                    const FileFormat &format);
+                    const FileFormat &format) const;
 
 private:
     template <typename Importer>
@@ -22,6 +22,7 @@
 
 #include <score/score.h>
 #include <score/utils/scorepolisher.h>
+#include <util/tracing.h>
 
 #include <boost/filesystem/fstream.hpp>
 
@@ -30,8 +31,13 @@ GpxImporter::GpxImporter()
 {
 }
 
-void GpxImporter::load(const boost::filesystem::path &filename, Score &score)
+void GpxImporter::load(const boost::filesystem::path &filename,
+                       Score &score) const
 {
+    Tracing::Span span("GpxImporter::load");
+    if (span.isActive())
+        span.setDetail(filename.string());
+
     // Load the data, decompress, and open as XML document.
     boost::filesystem::ifstream file(filename, std::ios::binary | std::ios::in);
     Gpx::FileSystem fs(file);
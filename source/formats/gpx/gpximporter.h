@@ -26,7 +26,7 @@ public:
     GpxImporter();
 
     virtual void load(const boost::filesystem::path &filename,
-                      Score &score) override;
+                      Score &score) const override;
 };
 
 #endif
@@ -25,6 +25,7 @@
 #include <score/score.h>
 #include <score/utils.h>
 #include <score/utils/scorepolisher.h>
+#include <util/tracing.h>
 
 #include <cmath>
 #include <optional>
@@ -38,8 +39,12 @@ GuitarProImporter::GuitarProImporter()
 }
 
 void GuitarProImporter::load(const boost::filesystem::path &filename,
-                             Score &score)
+                             Score &score) const
 {
+    Tracing::Span span("GuitarProImporter::load");
+    if (span.isActive())
+        span.setDetail(filename.string());
+
     boost::filesystem::ifstream in(filename, std::ios::binary | std::ios::in);
     Gp::InputStream stream(in);
 
@@ -41,7 +41,7 @@ public:
     GuitarProImporter();
 
     virtual void load(const boost::filesystem::path &filename,
-                      Score &score) override;
+                      Score &score) const override;
 
 private:
     static void convertHeader(const Gp::Header &header, ScoreInfo &info);
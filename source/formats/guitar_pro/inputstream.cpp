@@ -17,7 +17,9 @@
 
 #include "inputstream.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <map>
 
 #include <formats/fileformat.h>
@@ -31,10 +33,15 @@ const std::map<std::string, Gp::Version> theVersionStrings = {
     { "FICHIER GUITAR PRO v5.10", Gp::Version5_1 }
 };
 
-Gp::InputStream::InputStream(std::istream &stream) : myStream(stream)
+/// Offset of the first byte after the version string.
+static const size_t theVersionStringLength = 31;
+
+Gp::InputStream::InputStream(std::istream &stream) : myPosition(0)
 {
-    myStream.exceptions(std::istream::failbit | std::istream::badbit |
-                       std::istream::eofbit);
+    myData.assign(std::istreambuf_iterator<char>(stream),
+                  std::istreambuf_iterator<char>());
+    if (stream.bad())
+        throw FileFormatException("Error reading file.");
 
     const std::string versionString = readVersionString();
 
@@ -47,52 +54,74 @@ Gp::InputStream::InputStream(std::istream &stream) : myStream(stream)
 
 std::string Gp::InputStream::readVersionString()
 {
-    myStream.seekg(std::ios_base::beg);
+    myPosition = 0;
 
     // THe version consists of a 30 character string, although not all 30
     // characters may be used.
-    std::string version = readCharacterString<uint8_t>();
+    std::string version(readCharacterString<uint8_t>());
 
     // Skip past any unread characters to land at position 0x1f.
-    myStream.seekg(31, std::ios_base::beg);
+    myPosition = 0;
+    consume(theVersionStringLength);
 
     return version;
 }
 
 std::string Gp::InputStream::readString()
+{
+    return std::string(readStringView());
+}
+
+std::string Gp::InputStream::readIntString()
+{
+    return std::string(readIntStringView());
+}
+
+std::string Gp::InputStream::readFixedLengthString(uint32_t maxLength)
+{
+    return std::string(readFixedLengthStringView(maxLength));
+}
+
+std::string_view Gp::InputStream::readStringView()
 {
     const uint32_t size = read<uint32_t>();
 
-    std::string str = readCharacterString<uint8_t>();
+    std::string_view str = readCharacterString<uint8_t>();
     assert(size - 1 == str.length());
+    (void)size;
 
     return str;
 }
 
-std::string Gp::InputStream::readIntString()
+std::string_view Gp::InputStream::readIntStringView()
 {
     return readCharacterString<uint32_t>();
 }
 
-std::string Gp::InputStream::readFixedLengthString(uint32_t maxLength)
+std::string_view Gp::InputStream::readFixedLengthStringView(uint32_t maxLength)
 {
     const uint8_t actualLength = read<uint8_t>();
+    const size_t storedLength = (maxLength != 0) ? maxLength : actualLength;
 
-    std::string str;
-
-    if (maxLength != 0)
-        str.resize(maxLength);
-    else
-        str.resize(actualLength);
+    const char *data = consume(storedLength);
+    return std::string_view(data, std::min<size_t>(actualLength, storedLength));
+}
 
-    if (str.size() != 0)
-        myStream.read(&str[0], str.size());
+void Gp::InputStream::skip(int numBytes)
+{
+    assert(numBytes >= 0);
 
-    str.resize(actualLength);
-    return str;
+    // Skipping past the end is not an error by itself, since some files omit
+    // the trailing padding byte after the last measure. Any further reads will
+    // fail.
+    myPosition = std::min(myPosition + static_cast<size_t>(numBytes),
+                          myData.size());
 }
 
-void Gp::InputStream::skip(int numBytes)
+void Gp::InputStream::throwUnexpectedEnd(size_t n) const
 {
-    myStream.seekg(numBytes, std::ios_base::cur);
-}
\ No newline at end of file
+    throw FileFormatException(
+        "Unexpected end of file: attempted to read " + std::to_string(n) +
+        " bytes at offset " + std::to_string(myPosition) + ", but the file is " +
+        std::to_string(myData.size()) + " bytes long.");
+}
@@ -20,7 +20,11 @@
 
 #include <bitset>
 #include <cstdint>
+#include <cstring>
 #include <istream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "document.h"
@@ -30,12 +34,19 @@ namespace Gp
 
 typedef std::bitset<8> Flags;
 
+/// Reads the binary Guitar Pro format. The entire file is buffered in memory
+/// up front, so individual reads are simple bounds-checked loads from the
+/// buffer rather than calls into the underlying std::istream.
 class InputStream
 {
 public:
+    /// Reads the entire contents of the stream.
+    /// @throw FileFormatException
     InputStream(std::istream &stream);
 
     /// Reads simple data (e.g. uint32_t, int16_t) from the input stream.
+    /// Values are stored in little-endian order.
+    /// @throw FileFormatException if the end of the file is reached.
     template <class T>
     T read();
 
@@ -51,8 +62,19 @@ public:
     /// are skipped).
     std::string readFixedLengthString(uint32_t maxLength);
 
+    /// Equivalent to readString(), but returns a view into the stream's buffer
+    /// instead of allocating a new string. The view is valid for the lifetime
+    /// of the stream.
+    std::string_view readStringView();
+    /// Equivalent to readIntString(), but without allocating a new string.
+    std::string_view readIntStringView();
+    /// Equivalent to readFixedLengthString(), but without allocating a new
+    /// string.
+    std::string_view readFixedLengthStringView(uint32_t maxLength);
+
     std::string readVersionString();
 
+    /// Skips over the given number of bytes.
     void skip(int numBytes);
 
     Gp::Version version; // TODO - make private.
@@ -68,36 +90,71 @@ private:
     /// prefix type, to allow for strings prefixed with a 2-byte length value,
     /// 4-byte length value, etc
     template <class LengthPrefixType>
-    std::string readCharacterString();
+    std::string_view readCharacterString();
+
+    /// Returns a pointer to the next n bytes and advances past them.
+    /// @throw FileFormatException if fewer than n bytes remain.
+    const char *consume(size_t n);
 
-    std::istream &myStream;
+    [[noreturn]] void throwUnexpectedEnd(size_t n) const;
+
+    std::vector<char> myData;
+    size_t myPosition;
 };
 
 template <class T>
 inline T InputStream::read()
 {
     static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
-    T data;
-    myStream.read((char *)&data, sizeof(data));
-    return data;
+    const char *bytes = consume(sizeof(T));
+
+    if constexpr (std::is_same<T, bool>::value)
+        return *bytes != 0;
+    else if constexpr (std::is_integral<T>::value)
+    {
+        // Assemble the value byte by byte so that the result does not depend
+        // on the host's endianness.
+        typedef typename std::make_unsigned<T>::type UnsignedType;
+        UnsignedType value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            value |= static_cast<UnsignedType>(
+                static_cast<UnsignedType>(static_cast<uint8_t>(bytes[i]))
+                << (8 * i));
+        }
+
+        return static_cast<T>(value);
+    }
+    else
+    {
+        T data;
+        std::memcpy(&data, bytes, sizeof(data));
+        return data;
+    }
+}
+
+inline const char *InputStream::consume(size_t n)
+{
+    if (n > myData.size() - myPosition)
+        throwUnexpectedEnd(n);
+
+    const char *bytes = myData.data() + myPosition;
+    myPosition += n;
+    return bytes;
 }
 
 template <typename LengthPrefixType>
-inline std::string InputStream::readCharacterString()
+inline std::string_view InputStream::readCharacterString()
 {
     static_assert(std::is_integral<LengthPrefixType>::value,
                   "LengthPrefixType must be an integral type");
 
     const LengthPrefixType length = read<LengthPrefixType>();
+    if (length == 0)
+        return std::string_view();
 
-    std::string str;
-    str.resize(length);
-
-    if (length != 0)
-        myStream.read(&str[0], length);
-
-    return str;
+    return std::string_view(consume(length), length);
 }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -64,7 +64,8 @@ MidiExporter::MidiExporter(const SettingsManager &settings_manager)
 {
 }
 
-void MidiExporter::save(const boost::filesystem::path &filename, const Score &score)
+void MidiExporter::save(const boost::filesystem::path &filename,
+                        const Score &score) const
 {
     boost::filesystem::ofstream os(filename, std::ios::out | std::ios::binary);
     os.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
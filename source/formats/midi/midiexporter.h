@@ -29,7 +29,7 @@ public:
     MidiExporter(const SettingsManager &settings_manager);
 
     virtual void save(const boost::filesystem::path &filename,
-                      const Score &score) override;
+                      const Score &score) const override;
 
 private:
     static void writeHeader(std::ostream &os, const MidiFile &file);
@@ -18,6 +18,7 @@
 #ifndef FORMATS_POWERTAB_COMMON_H
 #define FORMATS_POWERTAB_COMMON_H
 
+#include <array>
 #include <formats/fileformat.h>
 
 inline FileFormat getPowerTabFileFormat()
@@ -25,4 +26,10 @@ inline FileFormat getPowerTabFileFormat()
 	return FileFormat("Power Tab Document", { "pt2" });
 }
 
+/// .pt2 files are normally gzip-compressed, but can optionally be compressed
+/// with zstd instead. The codec is identified by the magic number at the start
+/// of the file.
+const std::array<unsigned char, 4> theZstdMagicNumber = { 0x28, 0xb5, 0x2f,
+                                                          0xfd };
+
 #endif // COMMON_H
@@ -18,27 +18,70 @@
 #include "powertabexporter.h"
 
 #include "common.h"
+#include <algorithm>
+#include <app/settingsmanager.h>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
+#ifdef PTE_ENABLE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+#include <formats/settings.h>
 #include <score/score.h>
 #include <score/serialization.h>
 
-PowerTabExporter::PowerTabExporter()
-    : FileFormatExporter(getPowerTabFileFormat())
+PowerTabExporter::PowerTabExporter(const SettingsManager &settings_manager)
+    : FileFormatExporter(getPowerTabFileFormat()),
+      mySettingsManager(settings_manager)
 {
 }
 
 void PowerTabExporter::save(const boost::filesystem::path &filename,
-                            const Score &score)
+                            const Score &score) const
 {
-    // Use gzip to compress the resulting data.
+    int level;
+    bool use_zstd;
+    {
+        auto settings = mySettingsManager.getReadHandle();
+        level = settings->get(Settings::PowerTabCompressionLevel);
+        use_zstd = settings->get(Settings::PowerTabZstdCompression);
+    }
+    level = std::clamp(level, boost::iostreams::zlib::no_compression,
+                       boost::iostreams::zlib::best_compression);
+
     boost::filesystem::ofstream file(filename,
                                      std::ios::out | std::ios::binary);
+    if (!file)
+        throw FileFormatException("Could not open " + filename.string());
+
     boost::iostreams::filtering_ostreambuf out;
-    out.push(boost::iostreams::gzip_compressor());
+#ifdef PTE_ENABLE_ZSTD
+    if (use_zstd)
+    {
+        // zstd has no "no compression" level, and its levels above 9 are
+        // much slower than gzip's.
+        out.push(boost::iostreams::zstd_compressor(
+            boost::iostreams::zstd_params(std::max(level, 1))));
+    }
+    else
+#else
+    (void)use_zstd;
+#endif
+    {
+        // Use gzip by default, which older versions can read.
+        out.push(boost::iostreams::gzip_compressor(
+            boost::iostreams::gzip_params(level)));
+    }
     out.push(file);
 
+    // The data is compressed anyway, so don't bother with indentation.
     std::ostream compressed_output(&out);
-    ScoreUtils::save(compressed_output, "score", score);
+    ScoreUtils::save(compressed_output, "score", score,
+                     ScoreUtils::OutputFormat::Compact);
+
+    // Flush the compressor and close the file, to check for any errors.
+    out.reset();
+    file.close();
+    if (!compressed_output || !file)
+        throw FileFormatException("Error writing to " + filename.string());
 }
@@ -20,13 +20,18 @@
 
 #include <formats/fileformatmanager.h>
 
+class SettingsManager;
+
 class PowerTabExporter : public FileFormatExporter
 {
 public:
-    PowerTabExporter();
+    PowerTabExporter(const SettingsManager &settings_manager);
 
     virtual void save(const boost::filesystem::path &filename,
-                      const Score &score) override;
+                      const Score &score) const override;
+
+private:
+    const SettingsManager &mySettingsManager;
 };
 
 #endif
@@ -19,11 +19,34 @@
 
 #include "common.h"
 
+#include <algorithm>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
+#ifdef PTE_ENABLE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
 #include <score/score.h>
 #include <score/serialization.h>
+#include <util/tracing.h>
+
+/// Checks whether the file starts with the zstd magic number, and then rewinds
+/// the stream.
+static bool isZstdCompressed(std::istream &file)
+{
+    std::array<char, 4> header = {};
+    file.read(header.data(), header.size());
+    const bool is_zstd =
+        file.gcount() == static_cast<std::streamsize>(header.size()) &&
+        std::equal(header.begin(), header.end(), theZstdMagicNumber.begin(),
+                   [](char c, unsigned char magic) {
+                       return static_cast<unsigned char>(c) == magic;
+                   });
+
+    file.clear();
+    file.seekg(0);
+    return is_zstd;
+}
 
 PowerTabImporter::PowerTabImporter()
     : FileFormatImporter(getPowerTabFileFormat())
@@ -31,13 +54,28 @@ PowerTabImporter::PowerTabImporter()
 }
 
 void PowerTabImporter::load(const boost::filesystem::path &filename,
-                            Score &score)
+                            Score &score) const
 {
-    // The files are compressed by gzip, so we need to uncompress them before
-    // loading the data.
+    Tracing::Span span("PowerTabImporter::load");
+    if (span.isActive())
+        span.setDetail(filename.string());
+
+    // The files are compressed by gzip (or optionally zstd), so we need to
+    // uncompress them before loading the data.
     boost::filesystem::ifstream file(filename, std::ios::in | std::ios::binary);
     boost::iostreams::filtering_istreambuf in;
-    in.push(boost::iostreams::gzip_decompressor());
+    if (isZstdCompressed(file))
+    {
+#ifdef PTE_ENABLE_ZSTD
+        in.push(boost::iostreams::zstd_decompressor());
+#else
+        throw FileFormatException(
+            "This file uses zstd compression, which is not supported by this "
+            "build.");
+#endif
+    }
+    else
+        in.push(boost::iostreams::gzip_decompressor());
     in.push(file);
 
     std::istream compressed_input(&in);
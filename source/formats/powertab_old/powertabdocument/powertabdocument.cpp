@@ -240,6 +240,40 @@ void Document::Load(const boost::filesystem::path& fileName)
     m_fileName = fileName;
 }
 
+/// Loads a power tab file without storing the scores in the document. Each
+/// score is passed to the handler as soon as it has been read and is then
+/// freed, so only one score is kept in memory at a time.
+/// @param fileName Full path of the file to load.
+/// @param handler Called for the guitar score and then the bass score.
+/// @throw std::ifstream::failure
+void Document::Load(const boost::filesystem::path& fileName,
+                    const ScoreHandler& handler)
+{
+    boost::filesystem::ifstream fileStream(fileName, std::ifstream::in |
+                                                         std::ifstream::binary);
+    PowerTabInputStream stream(fileStream);
+
+    DeleteContents();
+
+    // read the header
+    if (!m_header.Deserialize(stream))
+    {
+        throw std::runtime_error("Invalid header");
+    }
+
+    const uint16_t version = m_header.GetVersion();
+
+    for (const char *name : { "Guitar Score", "Bass Score" })
+    {
+        Score score(name);
+        score.Deserialize(stream, version);
+        handler(score);
+    }
+
+    DeserializeSettings(stream, version);
+    m_fileName = fileName;
+}
+
 /// Deserializes a file from an input stream
 /// @param stream Input stream to read from
 /// @return True if the document was deserialized, false if not
@@ -253,6 +287,16 @@ bool Document::Deserialize(PowerTabInputStream& stream)
     m_scoreArray[0]->Deserialize(stream, version);
     m_scoreArray[1]->Deserialize(stream, version);
 
+    DeserializeSettings(stream, version);
+    return true;
+}
+
+/// Deserializes the document settings that follow the scores
+/// @param stream Input stream to read from
+/// @param version File version
+void Document::DeserializeSettings(PowerTabInputStream& stream,
+                                   uint16_t version)
+{
     // Read the document font settings
     for (size_t fontSettingIndex = 0; fontSettingIndex < NUM_FONT_SETTINGS;
          fontSettingIndex++)
@@ -265,7 +309,6 @@ bool Document::Deserialize(PowerTabInputStream& stream)
 
     // Read the line spacing and fade values
     stream >> m_tablatureStaffLineSpacing >> m_fadeIn >> m_fadeOut;
-    return true;
 }
 
 void Document::DeleteContents()
@@ -17,6 +17,7 @@
 
 #include <array>
 #include <boost/filesystem/path.hpp>
+#include <functional>
 #include <vector>
 
 namespace PowerTabDocument {
@@ -49,6 +50,7 @@ public:
     };
 
     using PathType = boost::filesystem::path;
+    using ScoreHandler = std::function<void(const Score&)>;
 
     // Member Variables
 private:
@@ -67,6 +69,7 @@ public:
 
     bool Save(const PathType& fileName) const;
     void Load(const PathType& fileName);
+    void Load(const PathType& fileName, const ScoreHandler& handler);
 
     bool Deserialize(PowerTabInputStream& stream);
 
@@ -105,6 +108,9 @@ public:
     // Fade Out Functions
     void SetFadeOut(uint32_t fadeOut);
     uint32_t GetFadeOut() const;
+
+private:
+    void DeserializeSettings(PowerTabInputStream& stream, uint16_t version);
 };
 
 }
@@ -157,18 +157,35 @@ int Score::FindSystemIndex(const SystemConstPtr& system) const
 /// Finds all of the tempo markers that are in the given system
 void Score::GetTempoMarkersInSystem(std::vector<TempoMarkerPtr>& tempoMarkers, SystemConstPtr system) const
 {
-    GetSymbolsInSystem(tempoMarkers, m_tempoMarkerArray, FindSystemIndex(system));
+    GetTempoMarkersInSystem(tempoMarkers, FindSystemIndex(system));
+}
+
+/// Finds all of the tempo markers that are in the system at the given index
+void Score::GetTempoMarkersInSystem(std::vector<TempoMarkerPtr>& tempoMarkers, size_t systemIndex) const
+{
+    GetSymbolsInSystem(tempoMarkers, m_tempoMarkerArray, systemIndex);
 }
 
 void Score::GetAlternateEndingsInSystem(std::vector<AlternateEndingPtr>& endings, SystemConstPtr system) const
 {
-    GetSymbolsInSystem(endings, m_alternateEndingArray, FindSystemIndex(system));
+    GetAlternateEndingsInSystem(endings, FindSystemIndex(system));
+}
+
+void Score::GetAlternateEndingsInSystem(std::vector<AlternateEndingPtr>& endings, size_t systemIndex) const
+{
+    GetSymbolsInSystem(endings, m_alternateEndingArray, systemIndex);
 }
 
 /// Returns all of the dynamics located in the given system
 void Score::GetDynamicsInSystem(std::vector<Score::DynamicPtr> &dynamics, Score::SystemConstPtr system) const
 {
-    GetSymbolsInSystem(dynamics, m_dynamicArray, FindSystemIndex(system));
+    GetDynamicsInSystem(dynamics, FindSystemIndex(system));
+}
+
+/// Returns all of the dynamics located in the system at the given index
+void Score::GetDynamicsInSystem(std::vector<Score::DynamicPtr> &dynamics, size_t systemIndex) const
+{
+    GetSymbolsInSystem(dynamics, m_dynamicArray, systemIndex);
 }
 
 /// Determines if a alternate ending index is valid
@@ -347,7 +364,13 @@ Score::GuitarInPtr Score::GetGuitarIn(size_t index) const
 void Score::GetGuitarInsInSystem(std::vector<Score::GuitarInPtr> &guitarIns,
                                  Score::SystemConstPtr system) const
 {
-    GetSymbolsInSystem(guitarIns, m_guitarInArray, FindSystemIndex(system));
+    GetGuitarInsInSystem(guitarIns, FindSystemIndex(system));
+}
+
+void Score::GetGuitarInsInSystem(std::vector<Score::GuitarInPtr> &guitarIns,
+                                 size_t systemIndex) const
+{
+    GetSymbolsInSystem(guitarIns, m_guitarInArray, systemIndex);
 }
 
 // Tempo Marker Functions
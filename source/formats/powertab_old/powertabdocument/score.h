@@ -91,6 +91,8 @@ public:
     GuitarInPtr GetGuitarIn(size_t index) const;
     void GetGuitarInsInSystem(std::vector<GuitarInPtr>& guitarIns,
                               SystemConstPtr system) const;
+    void GetGuitarInsInSystem(std::vector<GuitarInPtr>& guitarIns,
+                              size_t systemIndex) const;
 
 // Tempo Marker Functions
     bool IsValidTempoMarkerIndex(size_t index) const;
@@ -99,12 +101,15 @@ public:
 
     void GetTempoMarkersInSystem(std::vector<TempoMarkerPtr>& tempoMarkers,
                                  SystemConstPtr system) const;
+    void GetTempoMarkersInSystem(std::vector<TempoMarkerPtr>& tempoMarkers,
+                                 size_t systemIndex) const;
 
 // Dynamic Functions
     bool IsValidDynamicIndex(size_t index) const;
     size_t GetDynamicCount() const;
     DynamicPtr GetDynamic(size_t index) const;
     void GetDynamicsInSystem(std::vector<DynamicPtr>& dynamics, SystemConstPtr system) const;
+    void GetDynamicsInSystem(std::vector<DynamicPtr>& dynamics, size_t systemIndex) const;
 
 // Alternate Ending Functions
     bool IsValidAlternateEndingIndex(size_t index) const;
@@ -112,6 +117,7 @@ public:
     AlternateEndingPtr GetAlternateEnding(size_t index) const;
 
     void GetAlternateEndingsInSystem(std::vector<AlternateEndingPtr>& endings, SystemConstPtr system) const;
+    void GetAlternateEndingsInSystem(std::vector<AlternateEndingPtr>& endings, size_t systemIndex) const;
 
 // System Functions
     bool IsValidSystemIndex(size_t index) const;
@@ -37,8 +37,10 @@
 #include <score/systemlocation.h>
 #include <score/utils/scoremerger.h>
 #include <score/utils/scorepolisher.h>
+#include <util/tracing.h>
 
 #include <cmath>
+#include <memory_resource>
 
 PowerTabOldImporter::PowerTabOldImporter()
     : FileFormatImporter(FileFormat("Power Tab 1.7 Document", { "ptb" }))
@@ -46,10 +48,26 @@ PowerTabOldImporter::PowerTabOldImporter()
 }
 
 void PowerTabOldImporter::load(const boost::filesystem::path &filename,
-                               Score &score)
+                               Score &score) const
 {
+    Tracing::Span span("PowerTabOldImporter::load");
+    if (span.isActive())
+        span.setDetail(filename.string());
+
+    // Convert the guitar and bass scores as they are read, so that the old
+    // document model for only one of them is in memory at a time. The
+    // intermediate scores are discarded after merging, so they are built in a
+    // single arena and released together.
+    std::pmr::monotonic_buffer_resource arena;
+    Score guitarScore(&arena);
+    Score bassScore(&arena);
+    int scoreIndex = 0;
+
     PowerTabDocument::Document document;
-    document.Load(filename);
+    document.Load(filename, [&](const PowerTabDocument::Score &oldScore) {
+        convert(oldScore, scoreIndex++ == 0 ? guitarScore : bassScore);
+    });
+    assert(scoreIndex == 2);
 
     // TODO - handle font settings, etc.
     ScoreInfo info;
@@ -57,16 +75,8 @@ void PowerTabOldImporter::load(const boost::filesystem::path &filename,
     score.setScoreInfo(info);
     score.setLineSpacing(document.GetTablatureStaffLineSpacing());
     ScoreUtils::addStandardFilters(score);
-    
-    assert(document.GetNumberOfScores() == 2);
-
-    // Convert the guitar score.
-    Score guitarScore;
-    convert(*document.GetScore(0), guitarScore);
 
-    // Convert and then merge the bass score.
-    Score bassScore;
-    convert(*document.GetScore(1), bassScore);
+    // Merge the guitar and bass scores.
     ScoreMerger::merge(score, guitarScore, bassScore);
 
     // Reformat the score, since the guitar and bass score from v1.7 may have
@@ -157,7 +167,7 @@ void PowerTabOldImporter::convert(const PowerTabDocument::Score &oldScore,
     for (size_t i = 0; i < oldScore.GetSystemCount(); ++i)
     {
         System system;
-        convert(oldScore, oldScore.GetSystem(i), system);
+        convert(oldScore, i, system);
         score.insertSystem(system);
     }
 
@@ -206,9 +216,13 @@ void PowerTabOldImporter::convert(const PowerTabDocument::Tuning &oldTuning,
 }
 
 void PowerTabOldImporter::convert(const PowerTabDocument::Score &oldScore,
-                                  PowerTabDocument::Score::SystemConstPtr oldSystem,
-                                  System &system)
+                                  size_t systemIndex, System &system)
 {
+    // Look up symbols by the system's index rather than by searching for the
+    // system pointer, which made importing quadratic in the number of systems.
+    PowerTabDocument::Score::SystemConstPtr oldSystem =
+        oldScore.GetSystem(systemIndex);
+
     // Ensure that there are a reasonable number of positions in the staff
     // so that things aren't too stretched out.
     int lastPosition = 30;
@@ -243,7 +257,7 @@ void PowerTabOldImporter::convert(const PowerTabDocument::Score &oldScore,
 
     // Import tempo markers.
     std::vector<std::shared_ptr<PowerTabDocument::TempoMarker>> tempos;
-    oldScore.GetTempoMarkersInSystem(tempos, oldSystem);
+    oldScore.GetTempoMarkersInSystem(tempos, systemIndex);
     for (auto &tempo : tempos)
     {
         TempoMarker marker;
@@ -253,7 +267,7 @@ void PowerTabOldImporter::convert(const PowerTabDocument::Score &oldScore,
 
     // Import alternate endings.
     std::vector<std::shared_ptr<PowerTabDocument::AlternateEnding>> endings;
-    oldScore.GetAlternateEndingsInSystem(endings, oldSystem);
+    oldScore.GetAlternateEndingsInSystem(endings, systemIndex);
     for (auto &ending : endings)
     {
         AlternateEnding newEnding;
@@ -278,7 +292,7 @@ void PowerTabOldImporter::convert(const PowerTabDocument::Score &oldScore,
     }
 
     std::vector<PowerTabDocument::Score::DynamicPtr> dynamics;
-    oldScore.GetDynamicsInSystem(dynamics, oldSystem);
+    oldScore.GetDynamicsInSystem(dynamics, systemIndex);
 
     // Import staves.
     for (size_t i = 0; i < oldSystem->GetStaffCount(); ++i)
@@ -837,7 +851,7 @@ void PowerTabOldImporter::convertGuitarIns(
     for (size_t i = 0; i < oldScore.GetSystemCount(); ++i)
     {
         std::vector<PowerTabDocument::Score::GuitarInPtr> guitarIns;
-        oldScore.GetGuitarInsInSystem(guitarIns, oldScore.GetSystem(i));
+        oldScore.GetGuitarInsInSystem(guitarIns, i);
         if (guitarIns.empty())
             continue;
 
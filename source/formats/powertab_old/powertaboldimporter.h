@@ -62,7 +62,7 @@ class PowerTabOldImporter : public FileFormatImporter
 public:
     PowerTabOldImporter();
     virtual void load(const boost::filesystem::path &filename,
-                      Score &score) override;
+                      Score &score) const override;
 
 private:
     static void convert(const PowerTabDocument::PowerTabFileHeader &header,
@@ -75,8 +75,7 @@ private:
                         Tuning &tuning);
 
     static void convert(const PowerTabDocument::Score &oldScore,
-                        std::shared_ptr<const PowerTabDocument::System> oldSystem,
-                        System &system);
+                        size_t systemIndex, System &system);
 
     static void convert(const PowerTabDocument::Barline &oldBar, Barline &bar);
     static void convert(const PowerTabDocument::RehearsalSign &oldSign,
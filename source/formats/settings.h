@@ -0,0 +1,34 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FORMATS_SETTINGS_H
+#define FORMATS_SETTINGS_H
+
+#include <util/settingstree.h>
+
+/// Settings for importing and exporting files, and their default values.
+namespace Settings
+{
+    /// The zlib compression level (0-9) for .pt2 files. Lower levels save
+    /// faster but produce larger files.
+    extern const Setting<int> PowerTabCompressionLevel;
+    /// Whether .pt2 files are compressed with zstd rather than gzip. This is
+    /// much faster, but the files cannot be opened by older versions.
+    extern const Setting<bool> PowerTabZstdCompression;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bendcurve.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <score/generalmidi.h>
+
+namespace
+{
+const int MAX_QUARTER_TONES = 2 * BendCurve::PITCH_BEND_RANGE;
+
+/// Pitch wheel values for each number of quarter tones in the pitch bend
+/// range, from -MAX_QUARTER_TONES to MAX_QUARTER_TONES.
+using BendTable = std::array<uint8_t, 2 * MAX_QUARTER_TONES + 1>;
+
+constexpr BendTable computeBendTable()
+{
+    BendTable table{};
+
+    for (int i = 0; i < static_cast<int>(table.size()); ++i)
+    {
+        const int quarter_tones = i - MAX_QUARTER_TONES;
+
+        // Each quarter tone is 1 / MAX_QUARTER_TONES of the range above the
+        // default bend. Truncating the result matches the values that were
+        // previously computed with rationals.
+        table[i] = static_cast<uint8_t>(
+            (BendCurve::DEFAULT_BEND * MAX_QUARTER_TONES +
+             quarter_tones * (Midi::MAX_MIDI_CHANNEL_EFFECT_LEVEL -
+                              BendCurve::DEFAULT_BEND)) /
+            MAX_QUARTER_TONES);
+    }
+
+    return table;
+}
+
+constexpr BendTable theBendTable = computeBendTable();
+}
+
+BendCurve::BendCurve(const Resolution &resolution) : myResolution(resolution)
+{
+}
+
+uint8_t BendCurve::getBendAmount(int quarter_tones)
+{
+    quarter_tones =
+        std::clamp(quarter_tones, -MAX_QUARTER_TONES, MAX_QUARTER_TONES);
+    return theBendTable[quarter_tones + MAX_QUARTER_TONES];
+}
+
+void BendCurve::addPoint(int tick, uint8_t value)
+{
+    myPoints.push_back({ tick, value });
+}
+
+void BendCurve::addRamp(int start_tick, int duration, uint8_t start_value,
+                        uint8_t end_value)
+{
+    const int distance = std::abs(end_value - start_value);
+    if (!distance)
+        return;
+
+    // Use the smallest step that the resolution allows, but always reach the
+    // end value.
+    int num_steps = distance / std::max(myResolution.myMinStep, 1);
+    if (myResolution.myMinTicks > 0)
+        num_steps = std::min(num_steps, duration / myResolution.myMinTicks);
+    num_steps = std::max(num_steps, 1);
+
+    for (int i = 1; i <= num_steps; ++i)
+    {
+        const int tick = start_tick + i * duration / num_steps;
+        const int offset = i * distance / num_steps;
+
+        addPoint(tick, start_value < end_value ? start_value + offset
+                                               : start_value - offset);
+    }
+}
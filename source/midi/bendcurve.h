@@ -0,0 +1,75 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_BENDCURVE_H
+#define MIDI_BENDCURVE_H
+
+#include <cstdint>
+#include <vector>
+
+/// Builds the sequence of pitch wheel values for bends and slides.
+class BendCurve
+{
+public:
+    /// The pitch bend range (in semitones) that is set up for each channel.
+    static constexpr int PITCH_BEND_RANGE = 24;
+    /// The pitch wheel value for an unbent note.
+    static constexpr uint8_t DEFAULT_BEND = 64;
+
+    /// Controls how finely a gradual bend is divided into pitch wheel events.
+    struct Resolution
+    {
+        Resolution() : myMinTicks(1), myMinStep(1)
+        {
+        }
+
+        /// The minimum number of ticks between events.
+        int myMinTicks;
+        /// The minimum change in the pitch wheel value between events.
+        int myMinStep;
+    };
+
+    struct Point
+    {
+        int myTick;
+        uint8_t myValue;
+    };
+
+    explicit BendCurve(const Resolution &resolution = Resolution());
+
+    /// Returns the pitch wheel value for bending by the given number of
+    /// quarter tones, which is clamped to the pitch bend range.
+    static uint8_t getBendAmount(int quarter_tones);
+
+    /// Sets the pitch wheel value at the given tick.
+    void addPoint(int tick, uint8_t value);
+
+    /// Gradually moves the pitch wheel from the start value (which is assumed
+    /// to already be active) to the end value, which is reached at the end of
+    /// the duration.
+    void addRamp(int start_tick, int duration, uint8_t start_value,
+                 uint8_t end_value);
+
+    std::vector<Point> &getPoints() { return myPoints; }
+    const std::vector<Point> &getPoints() const { return myPoints; }
+
+private:
+    Resolution myResolution;
+    std::vector<Point> myPoints;
+};
+
+#endif
@@ -19,17 +19,6 @@
 
 #include <cassert>
 
-enum Controller : uint8_t
-{
-    ModWheel = 0x01,
-    DataEntryCoarse = 0x06,
-    ChannelVolume = 0x07,
-    DataEntryFine = 0x26,
-    HoldPedal = 0x40,
-    RpnLsb = 0x64,
-    RpnMsb = 0x65
-};
-
 enum MetaType : uint8_t
 {
     TrackEnd = 0x2f,
@@ -158,6 +147,11 @@ bool MidiEvent::isPositionChange() const
            myData[1] == theSysExManufacturerId;
 }
 
+bool MidiEvent::isChannelMessage() const
+{
+    return getStatusByte() < StatusByte::SysEx;
+}
+
 bool MidiEvent::isNoteOnOff() const
 {
     return (getStatusByte() & theStatusByteMask) == StatusByte::NoteOn ||
@@ -37,6 +37,17 @@ public:
         MetaMessage = 0xff
     };
 
+    enum Controller : uint8_t
+    {
+        ModWheel = 0x01,
+        DataEntryCoarse = 0x06,
+        ChannelVolume = 0x07,
+        DataEntryFine = 0x26,
+        HoldPedal = 0x40,
+        RpnLsb = 0x64,
+        RpnMsb = 0x65
+    };
+
     inline bool operator<(const MidiEvent &other) const
     {
         return myTicks < other.myTicks;
@@ -53,6 +64,9 @@ public:
     bool isProgramChange() const;
     bool isPositionChange() const;
     bool isNoteOnOff() const;
+    /// Returns whether this is a message for a specific channel (e.g. a note
+    /// or controller change), rather than a meta or system message.
+    bool isChannelMessage() const;
     uint8_t getChannel() const;
 
     static MidiEvent endOfTrack(int ticks);
@@ -18,7 +18,9 @@
 #include "midieventlist.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <optional>
 
 MidiEventList::MidiEventList(bool absolute_ticks)
     : myAbsoluteTicks(absolute_ticks)
@@ -35,11 +37,7 @@ void MidiEventList::convertToDeltaTicks()
 
     // First, sort by timestamp. Events for different voices may have been added
     // out of order.
-    std::stable_sort(myEvents.begin(), myEvents.end(),
-                     [](const MidiEvent &a, const MidiEvent &b)
-                     {
-                         return a.getTicks() < b.getTicks();
-                     });
+    sortByTicks();
 
     for (size_t i = myEvents.size() - 1; i >= 1; --i)
     {
@@ -61,6 +59,69 @@ void MidiEventList::convertToAbsoluteTicks()
     }
 }
 
+void MidiEventList::removeRedundantPitchWheelEvents()
+{
+    assert(myAbsoluteTicks);
+    sortByTicks();
+
+    const int num_channels = 16;
+    auto is_pitch_wheel = [](const MidiEvent &event) {
+        return (event.getStatusByte() & 0xf0) == MidiEvent::PitchWheel;
+    };
+
+    // Walk backwards to find events that are replaced by a later event for
+    // the same channel and tick, since they are never heard.
+    std::vector<bool> replaced(myEvents.size(), false);
+    std::array<std::optional<int>, num_channels> next_ticks;
+    for (size_t i = myEvents.size(); i-- > 0;)
+    {
+        const MidiEvent &event = myEvents[i];
+        if (!is_pitch_wheel(event))
+            continue;
+
+        std::optional<int> &next_tick = next_ticks[event.getChannel()];
+        replaced[i] = (next_tick == event.getTicks());
+        next_tick = event.getTicks();
+    }
+
+    // Then remove the replaced events, and any events that don't change the
+    // value for their channel. The initial value is not known, since the
+    // output device may have been used before.
+    std::array<std::optional<uint8_t>, num_channels> values;
+    size_t num_kept = 0;
+    for (size_t i = 0; i < myEvents.size(); ++i)
+    {
+        const MidiEvent &event = myEvents[i];
+        if (is_pitch_wheel(event))
+        {
+            if (replaced[i])
+                continue;
+
+            std::optional<uint8_t> &value = values[event.getChannel()];
+            const uint8_t new_value = event.getData()[2];
+            if (value == new_value)
+                continue;
+
+            value = new_value;
+        }
+
+        if (num_kept != i)
+            myEvents[num_kept] = std::move(myEvents[i]);
+        ++num_kept;
+    }
+
+    myEvents.erase(myEvents.begin() + num_kept, myEvents.end());
+}
+
+void MidiEventList::sortByTicks()
+{
+    std::stable_sort(myEvents.begin(), myEvents.end(),
+                     [](const MidiEvent &a, const MidiEvent &b)
+                     {
+                         return a.getTicks() < b.getTicks();
+                     });
+}
+
 void MidiEventList::concat(const MidiEventList &other)
 {
     myEvents.reserve(myEvents.size() + other.myEvents.size());
@@ -31,6 +31,11 @@ public:
     /// Convert the MIDI events from delta to absolute ticks.
     void convertToAbsoluteTicks();
 
+    /// Sorts the events by timestamp and removes pitch wheel events that do
+    /// not change the pitch for their channel, i.e. events that repeat the
+    /// current value or are replaced by another event at the same tick.
+    void removeRedundantPitchWheelEvents();
+
     void append(const MidiEvent &event) { myEvents.push_back(event); }
     void append(MidiEvent &&event)
     {
@@ -48,6 +53,8 @@ public:
     const_iterator end() const { return myEvents.end(); }
 
 private:
+    void sortByTicks();
+
     std::vector<MidiEvent> myEvents;
     bool myAbsoluteTicks;
 };
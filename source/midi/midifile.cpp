@@ -17,6 +17,7 @@
   
 #include "midifile.h"
 
+#include "bendcurve.h"
 #include "repeatcontroller.h"
 
 #include <boost/rational.hpp>
@@ -26,24 +27,20 @@
 #include <score/scorelocation.h>
 #include <score/systemlocation.h>
 #include <score/utils.h>
+#include <score/utils/voicetiming.h>
 #include <score/voiceutils.h>
+#include <util/tracing.h>
 
 static const int PERCUSSION_CHANNEL = 9;
 static const int METRONOME_CHANNEL = PERCUSSION_CHANNEL;
-static const int DEFAULT_PPQ = 480;
 
-static const int PITCH_BEND_RANGE = 24;
-static const int DEFAULT_BEND = 64;
+static const uint8_t DEFAULT_BEND = BendCurve::DEFAULT_BEND;
 static const int SLIDE_OUT_STEPS = 5;
 
-/// Pitch bend amount to bend a note by a quarter tone.
-static const boost::rational<int> BEND_QUARTER_TONE(
-    (Midi::MAX_MIDI_CHANNEL_EFFECT_LEVEL - DEFAULT_BEND), 2 * PITCH_BEND_RANGE);
-
-static const int SLIDE_BELOW_BEND = boost::rational_cast<int>(
-    DEFAULT_BEND - SLIDE_OUT_STEPS * 2 * BEND_QUARTER_TONE);
-static const int SLIDE_ABOVE_BEND = boost::rational_cast<int>(
-    DEFAULT_BEND + SLIDE_OUT_STEPS * 2 * BEND_QUARTER_TONE);
+static const uint8_t SLIDE_BELOW_BEND =
+    BendCurve::getBendAmount(-2 * SLIDE_OUT_STEPS);
+static const uint8_t SLIDE_ABOVE_BEND =
+    BendCurve::getBendAmount(2 * SLIDE_OUT_STEPS);
 
 enum Velocity : uint8_t
 {
@@ -129,8 +126,23 @@ MidiFile::MidiFile() : myTicksPerBeat(0)
 {
 }
 
+int MidiFile::getBeatDuration(const TempoMarker &marker)
+{
+    // Convert the values in the TempoMarker::BeatType enum to a factor that
+    // will scale the bpm value to be in terms of quarter notes.
+    boost::rational<int> scale(2, 1 << (marker.getBeatType() / 2));
+    if (marker.getBeatType() % 2 != 0)
+        scale *= boost::rational<int>(3, 2);
+
+    // Compute the number of microseconds per quarter note.
+    return boost::rational_cast<int>(
+        60000000 / (scale * marker.getBeatsPerMinute()));
+}
+
 void MidiFile::load(const Score &score, const LoadOptions &options)
 {
+    Tracing::Span span("MidiFile::load");
+
     myTicksPerBeat = DEFAULT_PPQ;
 
     RepeatController repeat_controller(score);
@@ -146,7 +158,8 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
             MidiEvent::volumeChange(0, getChannel(i), Dynamic::fff));
 
         for (const MidiEvent &event :
-             MidiEvent::pitchWheelRange(0, getChannel(i), PITCH_BEND_RANGE))
+             MidiEvent::pitchWheelRange(0, getChannel(i),
+                                        BendCurve::PITCH_BEND_RANGE))
         {
             regular_tracks[i].append(event);
         }
@@ -155,6 +168,8 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
 
     SystemLocation location(0, 0);
     std::vector<uint8_t> active_bends;
+    // The timings for each voice in the current system.
+    std::vector<std::vector<VoiceTiming>> voice_timings;
     int system_index = -1;
     int current_tick = 0;
     int current_tempo = Midi::BEAT_DURATION_120_BPM;
@@ -170,9 +185,22 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
         {
             active_bends.resize(system.getStaves().size(), DEFAULT_BEND);
             system_index = location.getSystem();
+
+            voice_timings.clear();
+            for (const Staff &staff : system.getStaves())
+            {
+                voice_timings.emplace_back();
+                for (const Voice &voice : staff.getVoices())
+                    voice_timings.back().emplace_back(voice);
+            }
         }
 
         const int start_tick = current_tick;
+        myBarStarts.push_back(
+            { start_tick,
+              SystemLocation(location.getSystem(), current_bar->getPosition()),
+              next_bar->getPosition(), start_tick });
+
         current_tempo =
             addTempoEvent(master_track, start_tick, current_tempo, system,
                           current_bar->getPosition(), next_bar->getPosition());
@@ -188,7 +216,8 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
                 const int end_tick = addEventsForBar(
                     regular_tracks, active_bends[staff_index], start_tick,
                     current_tempo, score, system, location.getSystem(), staff,
-                    staff_index, staff.getVoices()[voice_index], voice_index,
+                    staff_index, staff.getVoices()[voice_index],
+                    voice_timings[staff_index][voice_index], voice_index,
                     current_bar->getPosition(), next_bar->getPosition(),
                     options);
 
@@ -201,6 +230,7 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
             current_tick,
             generateMetronome(metronome_track, start_tick, system, *current_bar,
                               *next_bar, location, options));
+        myBarStarts.back().myEndTick = current_tick;
 
         location = moveToNextBar(
             metronome_track, current_tick, options.myRecordPositionChanges,
@@ -215,6 +245,7 @@ void MidiFile::load(const Score &score, const LoadOptions &options)
     for (MidiEventList &track : myTracks)
     {
         track.append(MidiEvent::endOfTrack(current_tick));
+        track.removeRedundantPitchWheelEvents();
         track.convertToDeltaTicks();
     }
 }
@@ -288,18 +319,7 @@ int MidiFile::addTempoEvent(MidiEventList &event_list, int current_tick,
     // If multiple tempo markers occur in a bar, just choose the last one.
     if (!markers.empty())
     {
-        const TempoMarker &marker = markers.back();
-
-        // Convert the values in the TempoMarker::BeatType enum to a factor that
-        // will scale the bpm value to be in terms of quarter notes.
-        boost::rational<int> scale(2, 1 << (marker.getBeatType() / 2));
-        if (marker.getBeatType() % 2 != 0)
-            scale *= boost::rational<int>(3, 2);
-
-        // Compute the number of microseconds per quarter note.
-        current_tempo = boost::rational_cast<int>(
-            60000000 / (scale * marker.getBeatsPerMinute()));
-
+        current_tempo = getBeatDuration(markers.back());
         event_list.append(MidiEvent::setTempo(current_tick, current_tempo));
     }
 
@@ -391,55 +411,22 @@ static int getArpeggioOffset(int ppq, int current_tempo)
         boost::rational<int>(current_tempo, ppq));
 }
 
-/// Holds basic information about a bend - used to simplify the generateBends
-/// function.
-struct BendEventInfo
-{
-    BendEventInfo(int tick, uint8_t bend_amount)
-        : myTick(tick), myBendAmount(bend_amount)
-    {
-    }
-
-    int myTick;
-    uint8_t myBendAmount;
-};
-
-static void generateGradualBend(std::vector<BendEventInfo> &bends,
-                                int start_tick, int duration, int start_bend,
-                                int release_bend)
-{
-    const int num_events = std::abs(start_bend - release_bend);
-    if (!num_events)
-        return;
-
-    const int event_duration = duration / num_events;
-    for (int i = 1; i <= num_events; ++i)
-    {
-        const int tick = start_tick + i * event_duration;
-        if (start_bend < release_bend)
-            bends.push_back(BendEventInfo(tick, start_bend + i));
-        else
-            bends.push_back(BendEventInfo(tick, start_bend - i));
-    }
-}
-
-static void generateBends(std::vector<BendEventInfo> &bends,
-                          uint8_t &active_bend, int start_tick, int duration,
-                          int ppq, const Note &note)
+static void generateBends(BendCurve &bends, uint8_t &active_bend,
+                          int start_tick, int duration, int ppq,
+                          const Note &note)
 {
     const Bend &bend = note.getBend();
 
-    const int bend_amount = boost::rational_cast<int>(
-        DEFAULT_BEND + bend.getBentPitch() * BEND_QUARTER_TONE);
-    const int release_amount = boost::rational_cast<int>(
-        DEFAULT_BEND + bend.getReleasePitch() * BEND_QUARTER_TONE);
+    const uint8_t bend_amount = BendCurve::getBendAmount(bend.getBentPitch());
+    const uint8_t release_amount =
+        BendCurve::getBendAmount(bend.getReleasePitch());
 
     switch (bend.getType())
     {
         case Bend::PreBend:
         case Bend::PreBendAndRelease:
         case Bend::PreBendAndHold:
-            bends.push_back(BendEventInfo(start_tick, bend_amount));
+            bends.addPoint(start_tick, bend_amount);
             break;
 
         case Bend::NormalBend:
@@ -448,22 +435,19 @@ static void generateBends(std::vector<BendEventInfo> &bends,
             if (bend.getDuration() == 0)
             {
                 // Bend over a 32nd note.
-                generateGradualBend(bends, start_tick, ppq / 8, DEFAULT_BEND,
-                                    bend_amount);
+                bends.addRamp(start_tick, ppq / 8, DEFAULT_BEND, bend_amount);
             }
             else if (bend.getDuration() == 1)
             {
                 // Bend over the current note duration.
-                generateGradualBend(bends, start_tick, duration, DEFAULT_BEND,
-                                    bend_amount);
+                bends.addRamp(start_tick, duration, DEFAULT_BEND, bend_amount);
             }
             // TODO - implement bends that stretch over multiple notes.
             break;
 
         case Bend::BendAndRelease:
             // Bend up to the bent pitch for half of the note duration.
-            generateGradualBend(bends, start_tick, duration / 2, DEFAULT_BEND,
-                                bend_amount);
+            bends.addRamp(start_tick, duration / 2, DEFAULT_BEND, bend_amount);
             break;
         default:
             break;
@@ -475,23 +459,20 @@ static void generateBends(std::vector<BendEventInfo> &bends,
         case Bend::PreBend:
         case Bend::ImmediateRelease:
         case Bend::NormalBend:
-            bends.push_back(
-                BendEventInfo(start_tick + duration, release_amount));
+            bends.addPoint(start_tick + duration, release_amount);
             break;
 
         case Bend::PreBendAndRelease:
-            generateGradualBend(bends, start_tick, duration, bend_amount,
-                                release_amount);
+            bends.addRamp(start_tick, duration, bend_amount, release_amount);
             break;
 
         case Bend::BendAndRelease:
-            generateGradualBend(bends, start_tick + duration / 2, duration / 2,
-                                bend_amount, release_amount);
+            bends.addRamp(start_tick + duration / 2, duration / 2,
+                          bend_amount, release_amount);
             break;
 
         case Bend::GradualRelease:
-            generateGradualBend(bends, start_tick, duration, active_bend,
-                                release_amount);
+            bends.addRamp(start_tick, duration, active_bend, release_amount);
             break;
         default:
             break;
@@ -505,13 +486,13 @@ static void generateBends(std::vector<BendEventInfo> &bends,
     else
     {
         // Always return to the default bend, regardless of the release pitch.
-        if (!bends.empty())
-            bends.back().myBendAmount = DEFAULT_BEND;
+        if (!bends.getPoints().empty())
+            bends.getPoints().back().myValue = DEFAULT_BEND;
         active_bend = DEFAULT_BEND;
     }
 }
 
-static void generateSlides(std::vector<BendEventInfo> &bends, int start_tick,
+static void generateSlides(BendCurve &bends, int start_tick,
                            int note_duration, int ppq, const Note &note,
                            const Note *next_note)
 {
@@ -520,17 +501,15 @@ static void generateSlides(std::vector<BendEventInfo> &bends, int start_tick,
         note.hasProperty(Note::SlideOutOfDownwards) ||
         note.hasProperty(Note::SlideOutOfUpwards))
     {
-        int bend_amount = DEFAULT_BEND;
+        uint8_t bend_amount = DEFAULT_BEND;
 
         if (note.hasProperty(Note::ShiftSlide) ||
             note.hasProperty(Note::LegatoSlide))
         {
             if (next_note)
             {
-                bend_amount = boost::rational_cast<int>(
-                    DEFAULT_BEND +
-                    (next_note->getFretNumber() - note.getFretNumber()) * 2 *
-                        BEND_QUARTER_TONE);
+                bend_amount = BendCurve::getBendAmount(
+                    (next_note->getFretNumber() - note.getFretNumber()) * 2);
             }
             else
             {
@@ -546,25 +525,23 @@ static void generateSlides(std::vector<BendEventInfo> &bends, int start_tick,
         // Start the slide in the last part of the note duration, to make it
         // somewhat more realistic-sounding.
         const int slide_duration = note_duration / 3;
-        generateGradualBend(bends, start_tick + note_duration - slide_duration,
-                            slide_duration, DEFAULT_BEND, bend_amount);
+        bends.addRamp(start_tick + note_duration - slide_duration,
+                      slide_duration, DEFAULT_BEND, bend_amount);
 
         // Reset pitch wheel after note is played.
-        bends.push_back(
-            BendEventInfo(start_tick + note_duration, DEFAULT_BEND));
+        bends.addPoint(start_tick + note_duration, DEFAULT_BEND);
     }
 
     if (note.hasProperty(Note::SlideIntoFromAbove) ||
         note.hasProperty(Note::SlideIntoFromBelow))
     {
-        int bend_amount = note.hasProperty(Note::SlideIntoFromAbove)
-                              ? SLIDE_ABOVE_BEND
-                              : SLIDE_BELOW_BEND;
+        uint8_t bend_amount = note.hasProperty(Note::SlideIntoFromAbove)
+                                  ? SLIDE_ABOVE_BEND
+                                  : SLIDE_BELOW_BEND;
 
         // Slide over a 16th note.
         const int slide_duration = ppq / 4;
-        generateGradualBend(bends, start_tick, slide_duration, bend_amount,
-                            DEFAULT_BEND);
+        bends.addRamp(start_tick, slide_duration, bend_amount, DEFAULT_BEND);
     }
 }
 
@@ -572,7 +549,8 @@ int MidiFile::addEventsForBar(
     std::vector<MidiEventList> &tracks, uint8_t &active_bend, int current_tick,
     int current_tempo, const Score &score, const System &system,
     int system_index, const Staff &staff, int staff_index, const Voice &voice,
-    int voice_index, int bar_start, int bar_end, const LoadOptions &options)
+    const VoiceTiming &voice_timing, int voice_index, int bar_start,
+    int bar_end, const LoadOptions &options)
 {
     ScoreLocation location(score, system_index, staff_index, voice_index);
     const Voice *prev_voice = VoiceUtils::getAdjacentVoice(location, -1);
@@ -626,8 +604,9 @@ int MidiFile::addEventsForBar(
             continue;
 
         const SystemLocation system_location(system_index, position);
-        int duration = boost::rational_cast<int>(
-            myTicksPerBeat * VoiceUtils::getDurationTime(voice, *pos));
+        int duration = static_cast<int>(voice_timing.getDuration(*pos) *
+                                        myTicksPerBeat /
+                                        VoiceTiming::TICKS_PER_QUARTER);
 
         if (pos->isRest())
         {
@@ -790,7 +769,7 @@ int MidiFile::addEventsForBar(
 
             // Generate all events that involve pitch bends.
             {
-                std::vector<BendEventInfo> bend_events;
+                BendCurve bend_events(options.myBendResolution);
 
                 if (note.hasProperty(Note::SlideIntoFromAbove) ||
                     note.hasProperty(Note::SlideIntoFromBelow) ||
@@ -811,14 +790,14 @@ int MidiFile::addEventsForBar(
                                   duration, myTicksPerBeat, note);
                 }
 
-                for (const BendEventInfo &event : bend_events)
+                for (const BendCurve::Point &event : bend_events.getPoints())
                 {
                     for (const ActivePlayer &player : active_players)
                     {
                         tracks[player.getPlayerNumber()].append(
                             MidiEvent::pitchWheel(event.myTick,
                                                   getChannel(player),
-                                                  event.myBendAmount));
+                                                  event.myValue));
                     }
                 }
             }
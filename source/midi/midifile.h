@@ -18,7 +18,9 @@
 #ifndef MIDI_MIDIFILE_H
 #define MIDI_MIDIFILE_H
 
+#include <midi/bendcurve.h>
 #include <midi/midieventlist.h>
+#include <score/systemlocation.h>
 
 #include <cstdint>
 #include <vector>
@@ -27,12 +29,16 @@ class Barline;
 class Score;
 class Staff;
 class System;
-class SystemLocation;
+class TempoMarker;
 class Voice;
+class VoiceTiming;
 
 class MidiFile
 {
 public:
+    /// The number of ticks per quarter note in the generated events.
+    static const int DEFAULT_PPQ = 480;
+
     struct LoadOptions
     {
         LoadOptions()
@@ -44,6 +50,9 @@ public:
               myMetronomePreset(0),
               myRecordPositionChanges(false)
         {
+            // Space out the events for gradual bends by at least a 256th
+            // note.
+            myBendResolution.myMinTicks = DEFAULT_PPQ / 64;
         }
 
         uint8_t myVibratoStrength;
@@ -53,15 +62,34 @@ public:
         uint8_t myWeakAccentVel;
         uint8_t myMetronomePreset;
         bool myRecordPositionChanges;
+        BendCurve::Resolution myBendResolution;
+    };
+
+    /// The start of a bar in playback order (i.e. after following repeats).
+    struct BarStart
+    {
+        int myTick;
+        /// The system and the position of the bar's starting barline.
+        SystemLocation myLocation;
+        /// The position of the bar's ending barline.
+        int myEndPosition;
+        /// The tick where the bar ends, which is also the start of the next
+        /// bar in playback order.
+        int myEndTick;
     };
 
     MidiFile();
 
+    /// Returns the duration of a quarter note (in microseconds) for the tempo
+    /// marker.
+    static int getBeatDuration(const TempoMarker &marker);
+
     void load(const Score &score, const LoadOptions &options);
 
     int getTicksPerBeat() const { return myTicksPerBeat; }
     std::vector<MidiEventList> &getTracks() { return myTracks; }
     const std::vector<MidiEventList> &getTracks() const { return myTracks; }
+    const std::vector<BarStart> &getBarStarts() const { return myBarStarts; }
 
 private:
     int generateMetronome(MidiEventList &event_list, int current_tick,
@@ -79,11 +107,13 @@ private:
                         int current_tempo, const Score &score,
                         const System &system, int system_index,
                         const Staff &staff, int staff_index, const Voice &voice,
-                        int voice_index, int bar_start, int bar_end,
+                        const VoiceTiming &voice_timing, int voice_index,
+                        int bar_start, int bar_end,
                         const LoadOptions &options);
 
     int myTicksPerBeat;
     std::vector<MidiEventList> myTracks;
+    std::vector<BarStart> myBarStarts;
 };
 
 #endif
@@ -0,0 +1,60 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midiloopbuffer.h"
+
+#include <iterator>
+#include <midi/midieventlist.h>
+#include <midi/midiseekindex.h>
+
+std::optional<MidiLoopBuffer> MidiLoopBuffer::create(
+    const MidiEventList &events, const MidiSeekIndex &index,
+    const SystemLocation &start, const SystemLocation &end)
+{
+    const std::vector<MidiSeekIndex::Entry> &entries = index.getEntries();
+
+    const MidiSeekIndex::Entry *first = index.find(start);
+    if (!first)
+        return std::nullopt;
+
+    const MidiSeekIndex::Entry *last =
+        index.find(end, std::distance(entries.data(), first));
+    if (!last)
+        return std::nullopt;
+
+    // The loop runs until the end of the last bar, and includes the events up
+    // to the start of the following bar (or the end of the score if this is
+    // the last bar).
+    const MidiSeekIndex::Entry *next = last + 1;
+    auto first_event = events.begin() + first->myEventIndex;
+    auto last_event = events.end();
+    if (next != entries.data() + entries.size())
+        last_event = events.begin() + next->myEventIndex;
+
+    MidiLoopBuffer buffer;
+    buffer.myStartLocation = first->myBar.myLocation;
+    buffer.myStartTick = first->myBar.myTick;
+    buffer.myEndTick = last->myBar.myEndTick;
+    buffer.myTempo = first->myTempo;
+    buffer.myRestoreEvents = MidiSeekIndex::getRestoreEvents(*first);
+
+    buffer.myEvents.assign(first_event, last_event);
+    for (MidiEvent &event : buffer.myEvents)
+        event.setTicks(event.getTicks() - buffer.myStartTick);
+
+    return buffer;
+}
@@ -0,0 +1,77 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_MIDILOOPBUFFER_H
+#define MIDI_MIDILOOPBUFFER_H
+
+#include <midi/midievent.h>
+#include <optional>
+#include <score/systemlocation.h>
+#include <vector>
+
+class MidiEventList;
+class MidiSeekIndex;
+
+/// A copy of the events for a range of bars, which can be replayed repeatedly
+/// without regenerating the MIDI file.
+class MidiLoopBuffer
+{
+public:
+    /// Copies the events from the first bar in playback order that contains
+    /// the start location, up to and including the next bar that contains the
+    /// end location. The events must be sorted and use absolute ticks.
+    /// Returns an empty optional if either location is not played.
+    static std::optional<MidiLoopBuffer> create(const MidiEventList &events,
+                                                const MidiSeekIndex &index,
+                                                const SystemLocation &start,
+                                                const SystemLocation &end);
+
+    /// Returns the events, with ticks relative to the start of the loop.
+    const std::vector<MidiEvent> &getEvents() const { return myEvents; }
+
+    /// Returns the events needed to restore the state of each channel at the
+    /// start of the loop.
+    const std::vector<MidiEvent> &getRestoreEvents() const
+    {
+        return myRestoreEvents;
+    }
+
+    /// Returns the location of the first bar.
+    const SystemLocation &getStartLocation() const { return myStartLocation; }
+
+    /// Returns the absolute tick where the loop starts.
+    int getStartTick() const { return myStartTick; }
+    /// Returns the absolute tick where the loop ends.
+    int getEndTick() const { return myEndTick; }
+    /// Returns the length of one iteration, in ticks.
+    int getLength() const { return myEndTick - myStartTick; }
+
+    /// Returns the tempo at the start of the loop.
+    int getTempo() const { return myTempo; }
+
+private:
+    MidiLoopBuffer() = default;
+
+    std::vector<MidiEvent> myEvents;
+    std::vector<MidiEvent> myRestoreEvents;
+    SystemLocation myStartLocation;
+    int myStartTick = 0;
+    int myEndTick = 0;
+    int myTempo = 0;
+};
+
+#endif
@@ -0,0 +1,185 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "midiseekindex.h"
+
+#include <iterator>
+#include <midi/midievent.h>
+#include <midi/midieventlist.h>
+#include <score/generalmidi.h>
+#include <util/tracing.h>
+
+namespace
+{
+/// Tracks the channel state while iterating through the events.
+struct ChannelTracker
+{
+    MidiSeekIndex::ChannelState myState;
+    /// The selected registered parameter number, which determines the meaning
+    /// of data entry messages.
+    uint8_t myRpnMsb = 0x7f;
+    uint8_t myRpnLsb = 0x7f;
+
+    void update(const MidiEvent &event)
+    {
+        const std::vector<uint8_t> &data = event.getData();
+
+        switch (event.getStatusByte() & 0xf0)
+        {
+            case MidiEvent::ProgramChange:
+                myState.myProgram = data[1];
+                break;
+            case MidiEvent::PitchWheel:
+                myState.myPitchWheel = data[2];
+                break;
+            case MidiEvent::ControlChange:
+                updateController(data[1], data[2]);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void updateController(uint8_t controller, uint8_t value)
+    {
+        switch (controller)
+        {
+            case MidiEvent::ChannelVolume:
+                myState.myVolume = value;
+                break;
+            case MidiEvent::ModWheel:
+                myState.myModWheel = value;
+                break;
+            case MidiEvent::HoldPedal:
+                myState.myHoldPedal = value;
+                break;
+            case MidiEvent::RpnMsb:
+                myRpnMsb = value;
+                break;
+            case MidiEvent::RpnLsb:
+                myRpnLsb = value;
+                break;
+            case MidiEvent::DataEntryCoarse:
+                // RPN 0 is the pitch bend range.
+                if (myRpnMsb == 0 && myRpnLsb == 0)
+                    myState.myPitchBendRange = value;
+                break;
+            default:
+                break;
+        }
+    }
+};
+}
+
+MidiSeekIndex::MidiSeekIndex(const MidiEventList &events,
+                             const std::vector<MidiFile::BarStart> &bars)
+{
+    Tracing::Span span("MidiSeekIndex::MidiSeekIndex");
+
+    std::array<ChannelTracker, NUM_CHANNELS> channels;
+    int tempo = Midi::BEAT_DURATION_120_BPM;
+
+    auto event = events.begin();
+    myEntries.reserve(bars.size());
+
+    for (const MidiFile::BarStart &bar : bars)
+    {
+        // Apply all events before the start of the bar.
+        for (; event != events.end() && event->getTicks() < bar.myTick;
+             ++event)
+        {
+            if (event->isTempoChange())
+                tempo = event->getTempo();
+            else if (event->isChannelMessage() && !event->isNoteOnOff())
+                channels[event->getChannel()].update(*event);
+        }
+
+        Entry entry;
+        entry.myBar = bar;
+        entry.myEventIndex = std::distance(events.begin(), event);
+        entry.myTempo = tempo;
+        for (int i = 0; i < NUM_CHANNELS; ++i)
+            entry.myChannels[i] = channels[i].myState;
+
+        myEntries.push_back(entry);
+    }
+}
+
+const MidiSeekIndex::Entry *MidiSeekIndex::find(const SystemLocation &location,
+                                                size_t first_entry) const
+{
+    for (size_t i = first_entry; i < myEntries.size(); ++i)
+    {
+        const Entry &entry = myEntries[i];
+        const SystemLocation &start = entry.myBar.myLocation;
+
+        if (start.getSystem() == location.getSystem() &&
+            start.getPosition() <= location.getPosition() &&
+            location.getPosition() < entry.myBar.myEndPosition)
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+std::vector<MidiEvent> MidiSeekIndex::getRestoreEvents(const Entry &entry)
+{
+    std::vector<MidiEvent> events;
+
+    for (uint8_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        const ChannelState &state = entry.myChannels[channel];
+
+        if (state.myProgram)
+        {
+            events.push_back(
+                MidiEvent::programChange(0, channel, *state.myProgram));
+        }
+        if (state.myVolume)
+        {
+            events.push_back(
+                MidiEvent::volumeChange(0, channel, *state.myVolume));
+        }
+        if (state.myModWheel)
+        {
+            events.push_back(
+                MidiEvent::modWheel(0, channel, *state.myModWheel));
+        }
+        if (state.myHoldPedal)
+        {
+            events.push_back(
+                MidiEvent::holdPedal(0, channel, *state.myHoldPedal >= 64));
+        }
+        if (state.myPitchBendRange)
+        {
+            for (MidiEvent &event : MidiEvent::pitchWheelRange(
+                     0, channel, *state.myPitchBendRange))
+            {
+                events.push_back(std::move(event));
+            }
+        }
+        if (state.myPitchWheel)
+        {
+            events.push_back(
+                MidiEvent::pitchWheel(0, channel, *state.myPitchWheel));
+        }
+    }
+
+    return events;
+}
@@ -0,0 +1,79 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_MIDISEEKINDEX_H
+#define MIDI_MIDISEEKINDEX_H
+
+#include <array>
+#include <midi/midifile.h>
+#include <optional>
+#include <score/systemlocation.h>
+#include <vector>
+
+class MidiEvent;
+class MidiEventList;
+
+/// Records the tempo and the state of each MIDI channel (instrument, volume,
+/// pitch bend, etc) at the start of every bar in playback order. This allows
+/// playback to begin at any bar without replaying all of the earlier events.
+class MidiSeekIndex
+{
+public:
+    static const int NUM_CHANNELS = 16;
+
+    /// The last value sent for each controller, if any.
+    struct ChannelState
+    {
+        std::optional<uint8_t> myProgram;
+        std::optional<uint8_t> myVolume;
+        std::optional<uint8_t> myModWheel;
+        std::optional<uint8_t> myHoldPedal;
+        std::optional<uint8_t> myPitchWheel;
+        std::optional<uint8_t> myPitchBendRange;
+    };
+
+    struct Entry
+    {
+        MidiFile::BarStart myBar;
+        /// Index of the first event at or after the start of the bar.
+        size_t myEventIndex;
+        /// The active tempo (microseconds per beat).
+        int myTempo;
+        std::array<ChannelState, NUM_CHANNELS> myChannels;
+    };
+
+    /// Builds the index from the events of all tracks, which must be sorted
+    /// and use absolute ticks.
+    MidiSeekIndex(const MidiEventList &events,
+                  const std::vector<MidiFile::BarStart> &bars);
+
+    /// Returns the first bar in playback order that contains the location, or
+    /// null if there is no such bar. The search begins at the given entry.
+    const Entry *find(const SystemLocation &location,
+                      size_t first_entry = 0) const;
+
+    /// Returns the events needed to restore the state of each channel at the
+    /// start of the bar.
+    static std::vector<MidiEvent> getRestoreEvents(const Entry &entry);
+
+    const std::vector<Entry> &getEntries() const { return myEntries; }
+
+private:
+    std::vector<Entry> myEntries;
+};
+
+#endif
@@ -0,0 +1,323 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "performancemap.h"
+
+#include <algorithm>
+#include <boost/rational.hpp>
+#include <map>
+#include <midi/midifile.h>
+#include <midi/repeatcontroller.h>
+#include <score/generalmidi.h>
+#include <score/score.h>
+#include <score/utils.h>
+#include <score/utils/voicetiming.h>
+
+int64_t PerformanceMap::Bar::getEndTime() const
+{
+    return myStartTime +
+           static_cast<int64_t>(myTicks) * myBeatDuration /
+               MidiFile::DEFAULT_PPQ;
+}
+
+PerformanceMap::PerformanceMap() : myAllModified(true)
+{
+}
+
+void PerformanceMap::markSystemModified(int system)
+{
+    if (system >= 0 && system < static_cast<int>(myModifiedSystems.size()))
+        myModifiedSystems[system] = true;
+    else
+        myAllModified = true;
+}
+
+void PerformanceMap::markAllModified()
+{
+    myAllModified = true;
+}
+
+void PerformanceMap::update(const Score &score)
+{
+    const size_t num_systems = score.getSystems().size();
+    if (num_systems != mySystems.size())
+        myAllModified = true;
+
+    bool modified = myAllModified;
+    mySystems.resize(num_systems);
+    myModifiedSystems.resize(num_systems);
+
+    for (size_t i = 0; i < num_systems; ++i)
+    {
+        if (myAllModified || myModifiedSystems[i])
+        {
+            mySystems[i] = computeTiming(score.getSystems()[i]);
+            myModifiedSystems[i] = false;
+            modified = true;
+        }
+    }
+
+    myAllModified = false;
+
+    // Repeats and directions may span multiple systems, so the playback order
+    // is always recomputed. This does not need to look at the notes.
+    if (modified)
+        computePlaybackOrder(score);
+}
+
+/// Returns the number of ticks that a voice advances by for the position,
+/// which matches how MidiFile generates events.
+static int getPositionTicks(const Voice &voice, const VoiceTiming &timing,
+                            const Position &pos, int bar_start, int bar_end)
+{
+    if (pos.hasProperty(Position::Acciaccatura) && !pos.isRest())
+        return 0;
+
+    const int ticks = static_cast<int>(timing.getDuration(pos) *
+                                       MidiFile::DEFAULT_PPQ /
+                                       VoiceTiming::TICKS_PER_QUARTER);
+
+    // A whole rest that is the only item in the bar lasts for the entire bar,
+    // which is already covered by the time signature.
+    if (pos.isRest() && pos.getDurationType() == Position::WholeNote)
+    {
+        auto others = ScoreUtils::findInRange(voice.getPositions(), bar_start,
+                                              bar_end - 1);
+        if (std::distance(others.begin(), others.end()) == 1)
+            return 0;
+    }
+
+    return ticks;
+}
+
+std::vector<PerformanceMap::BarTiming> PerformanceMap::computeTiming(
+    const System &system)
+{
+    std::vector<std::vector<VoiceTiming>> voice_timings;
+    for (const Staff &staff : system.getStaves())
+    {
+        voice_timings.emplace_back();
+        for (const Voice &voice : staff.getVoices())
+            voice_timings.back().emplace_back(voice);
+    }
+
+    std::vector<BarTiming> bars;
+    auto barlines = system.getBarlines();
+
+    for (auto it = barlines.begin(); std::next(it) != barlines.end(); ++it)
+    {
+        const Barline &bar = *it;
+        const Barline &next_bar = *std::next(it);
+
+        BarTiming timing;
+        timing.myPosition = bar.getPosition();
+        timing.myEndPosition = next_bar.getPosition();
+
+        auto markers = ScoreUtils::findInRange(
+            system.getTempoMarkers(), bar.getPosition(),
+            next_bar.getPosition() - 1);
+        if (!markers.empty())
+            timing.myBeatDuration = MidiFile::getBeatDuration(markers.back());
+
+        // The bar lasts for at least the length of the time signature, which
+        // may be extended by a multi-bar rest.
+        int num_repeats = 1;
+        int ticks = 0;
+
+        for (unsigned int staff_index = 0;
+             staff_index < system.getStaves().size(); ++staff_index)
+        {
+            const Staff &staff = system.getStaves()[staff_index];
+
+            for (unsigned int voice_index = 0;
+                 voice_index < staff.getVoices().size(); ++voice_index)
+            {
+                const Voice &voice = staff.getVoices()[voice_index];
+                const VoiceTiming &voice_timing =
+                    voice_timings[staff_index][voice_index];
+
+                int voice_ticks = 0;
+                for (const Position &pos : ScoreUtils::findInRange(
+                         voice.getPositions(), bar.getPosition(),
+                         next_bar.getPosition()))
+                {
+                    if (pos.hasMultiBarRest())
+                    {
+                        num_repeats =
+                            std::max(num_repeats, pos.getMultiBarRestCount());
+                    }
+
+                    if (pos.getPosition() < next_bar.getPosition())
+                    {
+                        voice_ticks +=
+                            getPositionTicks(voice, voice_timing, pos,
+                                             bar.getPosition(),
+                                             next_bar.getPosition());
+                    }
+                }
+
+                ticks = std::max(ticks, voice_ticks);
+            }
+        }
+
+        const TimeSignature &time_sig = bar.getTimeSignature();
+        const int pulse_ticks = boost::rational_cast<int>(
+            boost::rational<int>(4, time_sig.getBeatValue()) *
+            boost::rational<int>(time_sig.getBeatsPerMeasure(),
+                                 time_sig.getNumPulses()) *
+            MidiFile::DEFAULT_PPQ);
+
+        timing.myTicks = std::max(
+            ticks, num_repeats * time_sig.getNumPulses() * pulse_ticks);
+        bars.push_back(timing);
+    }
+
+    return bars;
+}
+
+void PerformanceMap::computePlaybackOrder(const Score &score)
+{
+    myBars.clear();
+    myBarsByLocation.clear();
+
+    RepeatController repeat_controller(score);
+    // The number of times each bar has been played so far.
+    std::map<std::pair<int, int>, int> pass_counts;
+
+    SystemLocation location(0, 0);
+    int64_t tick = 0;
+    int64_t time = 0;
+    int beat_duration = Midi::BEAT_DURATION_120_BPM;
+
+    while (location.getSystem() < static_cast<int>(mySystems.size()))
+    {
+        const std::vector<BarTiming> &bars = mySystems[location.getSystem()];
+        if (bars.empty())
+            break;
+
+        // Find the bar containing the location.
+        auto bar_it = std::upper_bound(
+            bars.begin(), bars.end(), location.getPosition(),
+            [](int position, const BarTiming &bar) {
+                return position < bar.myPosition;
+            });
+        if (bar_it != bars.begin())
+            --bar_it;
+        const BarTiming &bar_timing = *bar_it;
+
+        if (bar_timing.myBeatDuration)
+            beat_duration = *bar_timing.myBeatDuration;
+
+        Bar bar;
+        bar.myLocation =
+            SystemLocation(location.getSystem(), bar_timing.myPosition);
+        bar.myEndPosition = bar_timing.myEndPosition;
+        bar.myPass = pass_counts[{ location.getSystem(),
+                                   bar_timing.myPosition }]++;
+        bar.myStartTick = tick;
+        bar.myStartTime = time;
+        bar.myTicks = bar_timing.myTicks;
+        bar.myBeatDuration = beat_duration;
+        myBars.push_back(bar);
+
+        tick += bar.myTicks;
+        time = bar.getEndTime();
+
+        // Move to the next bar, following any repeats or directions.
+        const SystemLocation prev_location = location;
+        SystemLocation new_location;
+        location.setPosition(bar_timing.myEndPosition);
+
+        if (repeat_controller.checkForRepeat(prev_location, location,
+                                             new_location))
+        {
+            location = new_location;
+        }
+        else if (bar_timing.myEndPosition == bars.back().myEndPosition)
+        {
+            location.setSystem(location.getSystem() + 1);
+            location.setPosition(0);
+
+            if (repeat_controller.checkForRepeat(prev_location, location,
+                                                 new_location))
+            {
+                location = new_location;
+            }
+        }
+    }
+
+    myBarsByLocation.resize(myBars.size());
+    for (size_t i = 0; i < myBars.size(); ++i)
+        myBarsByLocation[i] = i;
+
+    // Bars with the same location are already ordered by pass.
+    std::stable_sort(myBarsByLocation.begin(), myBarsByLocation.end(),
+                     [&](size_t i, size_t j) {
+                         return myBars[i].myLocation < myBars[j].myLocation;
+                     });
+}
+
+int64_t PerformanceMap::getDuration() const
+{
+    return myBars.empty() ? 0 : myBars.back().getEndTime();
+}
+
+const PerformanceMap::Bar *PerformanceMap::findBarAtTime(int64_t time) const
+{
+    if (myBars.empty() || time < 0 || time >= getDuration())
+        return nullptr;
+
+    // Find the last bar that starts at or before the time.
+    auto it = std::upper_bound(
+        myBars.begin(), myBars.end(), time,
+        [](int64_t t, const Bar &bar) { return t < bar.myStartTime; });
+    return &*std::prev(it);
+}
+
+const PerformanceMap::Bar *PerformanceMap::findBar(
+    const SystemLocation &location, int pass) const
+{
+    // Find the first bar that starts after the location, and then step back
+    // to the bars that could contain it.
+    auto it = std::upper_bound(
+        myBarsByLocation.begin(), myBarsByLocation.end(), location,
+        [&](const SystemLocation &loc, size_t i) {
+            return loc < myBars[i].myLocation;
+        });
+
+    if (it == myBarsByLocation.begin())
+        return nullptr;
+
+    const SystemLocation &bar_location = myBars[*std::prev(it)].myLocation;
+    if (bar_location.getSystem() != location.getSystem() ||
+        location.getPosition() >= myBars[*std::prev(it)].myEndPosition)
+    {
+        return nullptr;
+    }
+
+    // Find the first pass through the bar.
+    auto first = std::lower_bound(
+        myBarsByLocation.begin(), it, bar_location,
+        [&](size_t i, const SystemLocation &loc) {
+            return myBars[i].myLocation < loc;
+        });
+
+    if (pass < 0 || pass >= std::distance(first, it))
+        return nullptr;
+
+    return &myBars[*(first + pass)];
+}
@@ -0,0 +1,108 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MIDI_PERFORMANCEMAP_H
+#define MIDI_PERFORMANCEMAP_H
+
+#include <cstdint>
+#include <optional>
+#include <score/systemlocation.h>
+#include <vector>
+
+class Score;
+class System;
+
+/// Describes when each bar of a score is played, with the bars listed in
+/// playback order (i.e. after following repeats and musical directions).
+/// This allows converting between score locations and elapsed time without
+/// generating the MIDI events for the score.
+/// The timing of each system is cached, so after an edit only the modified
+/// systems need to be recomputed.
+class PerformanceMap
+{
+public:
+    struct Bar
+    {
+        /// The system and the position of the bar's starting barline.
+        SystemLocation myLocation;
+        /// The position of the bar's ending barline.
+        int myEndPosition;
+        /// The number of times the bar was played previously, e.g. 1 for the
+        /// second time through a repeat.
+        int myPass;
+        /// The start of the bar, in MIDI ticks.
+        int64_t myStartTick;
+        /// The start of the bar, in microseconds.
+        int64_t myStartTime;
+        int myTicks;
+        /// The duration of a quarter note, in microseconds.
+        int myBeatDuration;
+
+        int64_t getEndTime() const;
+    };
+
+    PerformanceMap();
+
+    /// Marks a system as modified, so that its timing is recomputed on the
+    /// next call to update().
+    void markSystemModified(int system);
+    /// Marks all systems as modified, e.g. after systems were added or
+    /// removed.
+    void markAllModified();
+
+    /// Recomputes the timing of any modified systems, and then the order in
+    /// which the bars are played.
+    void update(const Score &score);
+
+    /// Returns the bars in playback order.
+    const std::vector<Bar> &getBars() const { return myBars; }
+
+    /// Returns the total playback time, in microseconds.
+    int64_t getDuration() const;
+
+    /// Returns the bar that is playing at the given time (in microseconds), or
+    /// null if the time is past the end of the score.
+    const Bar *findBarAtTime(int64_t time) const;
+
+    /// Returns the bar containing the location, for the given pass through
+    /// the bar. Returns null if the bar is not played that many times.
+    const Bar *findBar(const SystemLocation &location, int pass = 0) const;
+
+private:
+    /// The cached timing for a bar, which does not depend on other systems.
+    struct BarTiming
+    {
+        int myPosition;
+        int myEndPosition;
+        int myTicks;
+        /// The new tempo, if there is a tempo marker in the bar.
+        std::optional<int> myBeatDuration;
+    };
+
+    static std::vector<BarTiming> computeTiming(const System &system);
+    void computePlaybackOrder(const Score &score);
+
+    std::vector<std::vector<BarTiming>> mySystems;
+    std::vector<bool> myModifiedSystems;
+    bool myAllModified;
+
+    std::vector<Bar> myBars;
+    /// Indices into myBars, sorted by location and pass.
+    std::vector<size_t> myBarsByLocation;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include <score/timesignature.h>
 #include <score/voiceutils.h>
 #include <set>
+#include <util/tracing.h>
 
 const double LayoutInfo::STAFF_WIDTH = 750;
 const int LayoutInfo::NUM_STD_NOTATION_LINES = 5;
@@ -54,6 +55,8 @@ LayoutInfo::LayoutInfo(const Score &score, const System &system, int systemIndex
       myStdNotationStaffAboveSpacing(0),
       myStdNotationStaffBelowSpacing(0)
 {
+    Tracing::Span span("LayoutInfo::LayoutInfo");
+
     computePositionSpacing();
     calculateTabStaffBelowLayout();
     calculateTabStaffAboveLayout();
@@ -19,13 +19,13 @@
 
 #include <painters/layoutinfo.h>
 #include <score/position.h>
-#include <score/voiceutils.h>
+#include <score/utils/voicetiming.h>
 
-NoteStem::NoteStem(const Voice &voice, const Position &pos, double x,
+NoteStem::NoteStem(const VoiceTiming &timing, const Position &pos, double x,
                    double noteHeadWidth,
                    const std::vector<double> &noteLocations)
-    : myVoice(&voice),
-      myPosition(&pos),
+    : myPosition(&pos),
+      myDurationTime(VoiceTiming::toQuarterNotes(timing.getDuration(pos))),
       myX(x),
       myNoteHeadWidth(noteHeadWidth),
       myTop(0),
@@ -103,8 +103,7 @@ double NoteStem::getNoteHeadWidth() const
 
 double NoteStem::getDurationTime() const
 {
-    return boost::rational_cast<double>(
-        VoiceUtils::getDurationTime(*myVoice, *myPosition));
+    return myDurationTime;
 }
 
 int NoteStem::getPositionIndex() const
@@ -20,7 +20,7 @@
 
 #include <score/position.h>
 
-class Voice;
+class VoiceTiming;
 
 class NoteStem
 {
@@ -31,7 +31,7 @@ public:
         StemDown
     };
 
-    NoteStem(const Voice &voice, const Position &pos, double x,
+    NoteStem(const VoiceTiming &timing, const Position &pos, double x,
              double noteHeadWidth, const std::vector<double> &noteLocations);
 
     double getX() const;
@@ -90,8 +90,9 @@ private:
     static StemType computeStemDirection(std::vector<NoteStem> &stems,
                                          const std::vector<size_t> &group);
 
-    const Voice *myVoice;
     const Position *myPosition;
+    /// The position's duration, relative to a quarter note.
+    double myDurationTime;
     double myX;
     double myNoteHeadWidth;
     double myTop;
@@ -27,6 +27,7 @@
 #include <score/score.h>
 #include <score/tuning.h>
 #include <score/utils.h>
+#include <score/utils/voicetiming.h>
 #include <score/voiceutils.h>
 #include <unordered_map>
 
@@ -105,6 +106,7 @@ void StdNotationNote::getNotesInStaff(
     {
         std::vector<NoteStem> &stems = stemsByVoice[voiceIndex];
         std::vector<BeamGroup> &groups = groupsByVoice[voiceIndex];
+        const VoiceTiming timing(voice);
 
         for (const Barline &bar : system.getBarlines())
         {
@@ -132,7 +134,7 @@ void StdNotationNote::getNotesInStaff(
                 {
                     const double x = layout.getPositionX(pos.getPosition()) +
                                      0.5 * layout.getPositionSpacing();
-                    stems.push_back(NoteStem(voice, pos, x, 0, noteLocations));
+                    stems.push_back(NoteStem(timing, pos, x, 0, noteLocations));
                     continue;
                 }
 
@@ -212,7 +214,7 @@ void StdNotationNote::getNotesInStaff(
                 const double x = layout.getPositionX(pos.getPosition()) +
                         0.5 * (layout.getPositionSpacing() - noteHeadWidth);
                 stems.push_back(
-                    NoteStem(voice, pos, x, noteHeadWidth, noteLocations));
+                    NoteStem(timing, pos, x, noteHeadWidth, noteLocations));
             }
 
             computeBeaming(bar.getTimeSignature(), stems, firstStem, groups);
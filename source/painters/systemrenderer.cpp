@@ -40,8 +40,10 @@
 #include <score/scorelocation.h>
 #include <score/system.h>
 #include <score/utils.h>
+#include <score/utils/barindex.h>
 #include <score/voiceutils.h>
 #include <util/tostring.h>
+#include <util/tracing.h>
 
 #include <algorithm>
 
@@ -81,6 +83,8 @@ SystemRenderer::SystemRenderer(const ScoreArea *score_area, const Score &score,
 QGraphicsItem *SystemRenderer::operator()(const System &system,
                                           int systemIndex)
 {
+    Tracing::Span span("SystemRenderer::operator()");
+
     // Draw the bounding rectangle for the system.
     myParentSystem = new QGraphicsRectItem();
     myParentSystem->setPen(QPen(QBrush(QColor(0, 0, 0, 127)), 0.5));
@@ -186,12 +190,7 @@ void SystemRenderer::drawTabClef(double x, const LayoutInfo &layout,
 
 void SystemRenderer::drawBarNumber(int systemIndex, const LayoutInfo &layout)
 {
-    int number = 1;
-    for (int i = 0; i < systemIndex; ++i)
-    {
-        const System &system = myScore.getSystems()[i];
-        number += static_cast<int>(system.getBarlines().size()) - 1;
-    }
+    const int number = myScoreArea->getBarIndex().getFirstBar(systemIndex) + 1;
 
     auto text = new SimpleTextItem(QString::number(number), myPlainTextFont);
     text->setPos(-text->boundingRect().width() - LayoutInfo::BAR_NUMBER_PADDING,
@@ -0,0 +1,427 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCORE_BINARYSERIALIZATION_H
+#define SCORE_BINARYSERIALIZATION_H
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <boost/container/small_vector.hpp>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <cstdint>
+#include "fileversion.h"
+#include <istream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// A compact binary counterpart to the JSON archives in serialization.h, for
+/// short-lived data such as the clipboard. Objects are written using the same
+/// serialize() methods, but the field names are omitted and integers are
+/// stored as variable-length values. Unlike the JSON format, there is no
+/// support for skipping unknown fields, so the data should not be stored
+/// long-term.
+namespace ScoreUtils
+{
+class BinaryInputArchive
+{
+public:
+    static constexpr bool IsLoading = true;
+
+    explicit BinaryInputArchive(std::istream &is);
+
+    FileVersion version() const { return myVersion; }
+
+    template <typename T>
+    void operator()(const std::string & /*name*/, T &obj)
+    {
+        read(obj);
+    }
+
+private:
+    uint64_t readVarint();
+    int64_t readSignedVarint();
+    size_t readSize();
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type read(T &val)
+    {
+        // Small integer types are written through write(int), so only
+        // unsigned int and bool are stored without zigzag encoding.
+        if (std::is_same<T, unsigned int>::value ||
+            std::is_same<T, bool>::value)
+            val = static_cast<T>(readVarint());
+        else
+            val = static_cast<T>(readSignedVarint());
+    }
+
+    void read(std::string &str);
+
+    template <typename T, typename Alloc>
+    void read(std::vector<T, Alloc> &vec);
+
+    template <typename T, size_t N>
+    void read(boost::container::small_vector<T, N> &vec);
+
+    template <typename K, typename V, typename C>
+    void read(std::map<K, V, C> &map);
+
+    template <typename T, size_t N>
+    void read(std::array<T, N> &arr);
+
+    template <size_t N>
+    void read(std::bitset<N> &bits);
+
+    template <typename T>
+    void read(std::optional<T> &val);
+
+    void read(boost::gregorian::date &date);
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type read(T &val)
+    {
+        val = static_cast<T>(readSignedVarint());
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value>::type read(T &obj)
+    {
+        obj.serialize(*this, myVersion);
+    }
+
+    std::istream &myStream;
+    /// Offset of the end of the stream, if it is known.
+    std::optional<std::istream::pos_type> myEnd;
+    FileVersion myVersion;
+};
+
+class BinaryOutputArchive
+{
+public:
+    static constexpr bool IsLoading = false;
+
+    BinaryOutputArchive(std::ostream &os, FileVersion version);
+
+    template <typename T>
+    void operator()(const std::string & /*name*/, const T &obj)
+    {
+        write(obj);
+    }
+
+private:
+    void writeVarint(uint64_t val);
+    void writeSignedVarint(int64_t val);
+
+    void write(int val) { writeSignedVarint(val); }
+    void write(unsigned int val) { writeVarint(val); }
+    void write(bool val) { writeVarint(val ? 1 : 0); }
+    void write(const std::string &str);
+
+    template <typename T, typename Alloc>
+    void write(const std::vector<T, Alloc> &vec);
+
+    template <typename T, size_t N>
+    void write(const boost::container::small_vector<T, N> &vec);
+
+    template <typename K, typename V, typename C>
+    void write(const std::map<K, V, C> &map);
+
+    template <typename T, size_t N>
+    void write(const std::array<T, N> &arr);
+
+    template <size_t N>
+    void write(const std::bitset<N> &bits);
+
+    template <typename T>
+    void write(const std::optional<T> &val);
+
+    void write(const boost::gregorian::date &date);
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type write(const T &val)
+    {
+        writeSignedVarint(static_cast<int>(val));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value>::type write(const T &obj)
+    {
+        const_cast<T &>(obj).serialize(*this, myVersion);
+    }
+
+    std::ostream &myStream;
+    const FileVersion myVersion;
+};
+
+/// Identifies the start of the binary data, followed by the name of the
+/// object and the file version.
+const char theBinaryMagic[] = { 'P', 'T', 'B', '\x01' };
+
+template <typename T>
+void saveBinary(std::ostream &output, const std::string &name, const T &obj)
+{
+    output.write(theBinaryMagic, sizeof(theBinaryMagic));
+
+    BinaryOutputArchive ar(output, FileVersion::LATEST_VERSION);
+    ar("name", name);
+    ar(name, obj);
+}
+
+template <typename T>
+void loadBinary(std::istream &input, const std::string &name, T &obj)
+{
+    std::array<char, sizeof(theBinaryMagic)> magic = {};
+    input.read(magic.data(), magic.size());
+    if (!std::equal(magic.begin(), magic.end(), std::begin(theBinaryMagic)))
+        throw std::runtime_error("Invalid binary data");
+
+    BinaryInputArchive ar(input);
+    if (ar.version() > FileVersion::LATEST_VERSION ||
+        ar.version() < FileVersion::INITIAL_VERSION)
+    {
+        throw std::runtime_error("Invalid file version");
+    }
+
+    std::string storedName;
+    ar("name", storedName);
+    if (storedName != name)
+    {
+        throw std::runtime_error("Unexpected binary data: found " +
+                                 storedName + ", expected " + name);
+    }
+
+    ar(name, obj);
+}
+
+inline BinaryInputArchive::BinaryInputArchive(std::istream &is)
+    : myStream(is), myVersion(FileVersion::INITIAL_VERSION)
+{
+    const auto pos = myStream.tellg();
+    if (pos != std::istream::pos_type(-1))
+    {
+        myStream.seekg(0, std::ios::end);
+        myEnd = myStream.tellg();
+        myStream.seekg(pos);
+    }
+
+    read(myVersion);
+}
+
+inline uint64_t BinaryInputArchive::readVarint()
+{
+    uint64_t val = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const int c = myStream.get();
+        if (c == std::char_traits<char>::eof())
+            throw std::runtime_error("Unexpected end of binary data");
+
+        val |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return val;
+    }
+
+    throw std::runtime_error("Invalid variable-length integer");
+}
+
+inline int64_t BinaryInputArchive::readSignedVarint()
+{
+    // Zigzag decoding, so that small negative numbers are also compact.
+    const uint64_t val = readVarint();
+    return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+inline size_t BinaryInputArchive::readSize()
+{
+    const uint64_t size = readVarint();
+
+    // Guard against allocating huge containers from corrupt data. Every
+    // element takes at least one byte.
+    if (myEnd && size > static_cast<uint64_t>(*myEnd - myStream.tellg()))
+        throw std::runtime_error("Invalid container size in binary data");
+
+    return static_cast<size_t>(size);
+}
+
+inline void BinaryInputArchive::read(std::string &str)
+{
+    str.resize(readSize());
+    myStream.read(&str[0], static_cast<std::streamsize>(str.size()));
+    if (!myStream)
+        throw std::runtime_error("Unexpected end of binary data");
+}
+
+template <typename T, typename Alloc>
+void BinaryInputArchive::read(std::vector<T, Alloc> &vec)
+{
+    vec.resize(readSize());
+    for (T &obj : vec)
+        read(obj);
+}
+
+template <typename T, size_t N>
+void BinaryInputArchive::read(boost::container::small_vector<T, N> &vec)
+{
+    vec.resize(readSize());
+    for (T &obj : vec)
+        read(obj);
+}
+
+template <typename K, typename V, typename C>
+void BinaryInputArchive::read(std::map<K, V, C> &map)
+{
+    map.clear();
+
+    const size_t size = readSize();
+    for (size_t i = 0; i < size; ++i)
+    {
+        K key;
+        read(key);
+        read(map[key]);
+    }
+}
+
+template <typename T, size_t N>
+void BinaryInputArchive::read(std::array<T, N> &arr)
+{
+    for (T &obj : arr)
+        read(obj);
+}
+
+template <size_t N>
+void BinaryInputArchive::read(std::bitset<N> &bits)
+{
+    static_assert(N <= 64, "Bitset is too large");
+    bits = std::bitset<N>(static_cast<unsigned long long>(readVarint()));
+}
+
+template <typename T>
+void BinaryInputArchive::read(std::optional<T> &val)
+{
+    bool hasValue;
+    read(hasValue);
+
+    if (hasValue)
+    {
+        T data;
+        read(data);
+        val = data;
+    }
+    else
+        val.reset();
+}
+
+inline void BinaryInputArchive::read(boost::gregorian::date &date)
+{
+    std::string date_str;
+    read(date_str);
+    date = boost::gregorian::from_undelimited_string(date_str);
+}
+
+inline BinaryOutputArchive::BinaryOutputArchive(std::ostream &os,
+                                                FileVersion version)
+    : myStream(os), myVersion(version)
+{
+    write(myVersion);
+}
+
+inline void BinaryOutputArchive::writeVarint(uint64_t val)
+{
+    while (val >= 0x80)
+    {
+        myStream.put(static_cast<char>((val & 0x7f) | 0x80));
+        val >>= 7;
+    }
+
+    myStream.put(static_cast<char>(val));
+}
+
+inline void BinaryOutputArchive::writeSignedVarint(int64_t val)
+{
+    writeVarint((static_cast<uint64_t>(val) << 1) ^
+                static_cast<uint64_t>(val >> 63));
+}
+
+inline void BinaryOutputArchive::write(const std::string &str)
+{
+    writeVarint(str.size());
+    myStream.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+template <typename T, typename Alloc>
+void BinaryOutputArchive::write(const std::vector<T, Alloc> &vec)
+{
+    writeVarint(vec.size());
+    for (const T &obj : vec)
+        write(obj);
+}
+
+template <typename T, size_t N>
+void BinaryOutputArchive::write(
+    const boost::container::small_vector<T, N> &vec)
+{
+    writeVarint(vec.size());
+    for (const T &obj : vec)
+        write(obj);
+}
+
+template <typename K, typename V, typename C>
+void BinaryOutputArchive::write(const std::map<K, V, C> &map)
+{
+    writeVarint(map.size());
+    for (const auto &pair : map)
+    {
+        write(pair.first);
+        write(pair.second);
+    }
+}
+
+template <typename T, size_t N>
+void BinaryOutputArchive::write(const std::array<T, N> &arr)
+{
+    for (const T &obj : arr)
+        write(obj);
+}
+
+template <size_t N>
+void BinaryOutputArchive::write(const std::bitset<N> &bits)
+{
+    static_assert(N <= 64, "Bitset is too large");
+    writeVarint(bits.to_ullong());
+}
+
+template <typename T>
+void BinaryOutputArchive::write(const std::optional<T> &val)
+{
+    write(val.has_value());
+    if (val)
+        write(*val);
+}
+
+inline void BinaryOutputArchive::write(const boost::gregorian::date &date)
+{
+    write(boost::gregorian::to_iso_string(date));
+}
+}
+
+#endif
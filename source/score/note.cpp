@@ -36,30 +36,97 @@ namespace {
     };
 }
 
-Note::Note()
-    : myString(0),
-      myFretNumber(0),
-      myTrilledFret(-1),
-      myTappedHarmonicFret(-1)
+Note::Note() : Note(0, 0)
 {
 }
 
 Note::Note(int string, int fretNumber)
-    : myString(string),
-      myFretNumber(fretNumber),
-      myTrilledFret(-1),
-      myTappedHarmonicFret(-1)
+    : mySimpleProperties(0),
+      myString(static_cast<int16_t>(string)),
+      myFretNumber(static_cast<int16_t>(fretNumber))
 {
 }
 
+Note::Note(const Note &other)
+    : myColdProperties(other.myColdProperties
+                           ? std::make_unique<ColdProperties>(
+                                 *other.myColdProperties)
+                           : nullptr),
+      mySimpleProperties(other.mySimpleProperties),
+      myString(other.myString),
+      myFretNumber(other.myFretNumber)
+{
+}
+
+Note::~Note() = default;
+
+Note &Note::operator=(const Note &other)
+{
+    if (this != &other)
+    {
+        if (!other.myColdProperties)
+            myColdProperties.reset();
+        else if (myColdProperties)
+            *myColdProperties = *other.myColdProperties;
+        else
+        {
+            myColdProperties =
+                std::make_unique<ColdProperties>(*other.myColdProperties);
+        }
+
+        mySimpleProperties = other.mySimpleProperties;
+        myString = other.myString;
+        myFretNumber = other.myFretNumber;
+    }
+
+    return *this;
+}
+
 bool Note::operator==(const Note &other) const
 {
+    const ColdProperties &cold = getColdProperties();
+    const ColdProperties &otherCold = other.getColdProperties();
+
     return myString == other.myString && myFretNumber == other.myFretNumber &&
            mySimpleProperties == other.mySimpleProperties &&
-           myTrilledFret == other.myTrilledFret &&
-           myTappedHarmonicFret == other.myTappedHarmonicFret &&
-           myArtificialHarmonic == other.myArtificialHarmonic &&
-           myBend == other.myBend;
+           cold.myTrilledFret == otherCold.myTrilledFret &&
+           cold.myTappedHarmonicFret == otherCold.myTappedHarmonicFret &&
+           cold.myArtificialHarmonic == otherCold.myArtificialHarmonic &&
+           cold.myBend == otherCold.myBend;
+}
+
+bool Note::ColdProperties::isEmpty() const
+{
+    return myTrilledFret == -1 && myTappedHarmonicFret == -1 &&
+           !myArtificialHarmonic && !myBend && !myLeftHandFingering;
+}
+
+const Note::ColdProperties &Note::getColdProperties() const
+{
+    static const ColdProperties theEmptyProperties;
+    return myColdProperties ? *myColdProperties : theEmptyProperties;
+}
+
+Note::ColdProperties &Note::editColdProperties()
+{
+    if (!myColdProperties)
+        myColdProperties = std::make_unique<ColdProperties>();
+
+    return *myColdProperties;
+}
+
+void Note::setColdProperties(ColdProperties &&cold)
+{
+    if (cold.isEmpty())
+        myColdProperties.reset();
+    else
+        editColdProperties() = std::move(cold);
+}
+
+void Note::releaseEmptyColdProperties()
+{
+    if (myColdProperties && myColdProperties->isEmpty())
+        myColdProperties.reset();
 }
 
 int Note::getString() const
@@ -69,7 +136,7 @@ int Note::getString() const
 
 void Note::setString(int string)
 {
-    myString = string;
+    myString = static_cast<int16_t>(string);
 }
 
 int Note::getFretNumber() const
@@ -79,16 +146,18 @@ int Note::getFretNumber() const
 
 void Note::setFretNumber(int fret)
 {
-    myFretNumber = fret;
+    myFretNumber = static_cast<int16_t>(fret);
 }
 
 bool Note::hasProperty(SimpleProperty property) const
 {
-    return mySimpleProperties.test(property);
+    return (mySimpleProperties >> property) & 1u;
 }
 
 void Note::setProperty(SimpleProperty property, bool set)
 {
+    auto mask = [](int p) { return uint32_t(1) << p; };
+
     // Handle any mutually exclusive properties.
     if (set)
     {
@@ -96,35 +165,38 @@ void Note::setProperty(SimpleProperty property, bool set)
         if (property >= Octave8va && property <= Octave15mb)
         {
             for (int p = Octave8va; p <= Octave15mb; ++p)
-                mySimpleProperties.set(static_cast<SimpleProperty>(p), false);
+                mySimpleProperties &= ~mask(p);
         }
 
         // Clear all hammeron/pulloff properties.
         if (property >= HammerOnOrPullOff && property <= PullOffToNowhere)
         {
             for (int p = HammerOnOrPullOff; p <= PullOffToNowhere; ++p)
-                mySimpleProperties.set(static_cast<SimpleProperty>(p), false);
+                mySimpleProperties &= ~mask(p);
         }
 
         // Clear any mutually-exclusive slide types.
         if (property == SlideIntoFromAbove)
-            mySimpleProperties.set(SlideIntoFromBelow, false);
+            mySimpleProperties &= ~mask(SlideIntoFromBelow);
         if (property == SlideIntoFromBelow)
-            mySimpleProperties.set(SlideIntoFromAbove, false);
+            mySimpleProperties &= ~mask(SlideIntoFromAbove);
 
         if (property >= ShiftSlide && property <= SlideOutOfUpwards)
         {
             for (int p = ShiftSlide; p <= SlideOutOfUpwards; ++p)
-                mySimpleProperties.set(static_cast<SimpleProperty>(p), false);
+                mySimpleProperties &= ~mask(p);
         }
     }
 
-    mySimpleProperties.set(property, set);
+    if (set)
+        mySimpleProperties |= mask(property);
+    else
+        mySimpleProperties &= ~mask(property);
 }
 
 bool Note::hasTrill() const
 {
-    return myTrilledFret != -1;
+    return getColdProperties().myTrilledFret != -1;
 }
 
 int Note::getTrilledFret() const
@@ -132,7 +204,7 @@ int Note::getTrilledFret() const
     if (!hasTrill())
         throw std::logic_error("Note does not have a trill");
 
-    return myTrilledFret;
+    return getColdProperties().myTrilledFret;
 }
 
 void Note::setTrilledFret(int fret)
@@ -140,17 +212,21 @@ void Note::setTrilledFret(int fret)
     if (fret < 0)
         throw std::out_of_range("Invalid fret number");
 
-    myTrilledFret = fret;
+    editColdProperties().myTrilledFret = fret;
 }
 
 void Note::clearTrill()
 {
-    myTrilledFret = -1;
+    if (myColdProperties)
+    {
+        myColdProperties->myTrilledFret = -1;
+        releaseEmptyColdProperties();
+    }
 }
 
 bool Note::hasTappedHarmonic() const
 {
-    return myTappedHarmonicFret != -1;
+    return getColdProperties().myTappedHarmonicFret != -1;
 }
 
 int Note::getTappedHarmonicFret() const
@@ -158,7 +234,7 @@ int Note::getTappedHarmonicFret() const
     if (!hasTappedHarmonic())
         throw std::logic_error("Note does not have a tapped harmonic");
 
-    return myTappedHarmonicFret;
+    return getColdProperties().myTappedHarmonicFret;
 }
 
 void Note::setTappedHarmonicFret(int fret)
@@ -166,72 +242,88 @@ void Note::setTappedHarmonicFret(int fret)
     if (fret < 0)
         throw std::out_of_range("Invalid fret number");
 
-    myTappedHarmonicFret = fret;
+    editColdProperties().myTappedHarmonicFret = fret;
 }
 
 void Note::clearTappedHarmonic()
 {
-    myTappedHarmonicFret = -1;
+    if (myColdProperties)
+    {
+        myColdProperties->myTappedHarmonicFret = -1;
+        releaseEmptyColdProperties();
+    }
 }
 
 bool Note::hasArtificialHarmonic() const
 {
-    return myArtificialHarmonic.has_value();
+    return getColdProperties().myArtificialHarmonic.has_value();
 }
 
 const ArtificialHarmonic &Note::getArtificialHarmonic() const
 {
-    return *myArtificialHarmonic;
+    return *getColdProperties().myArtificialHarmonic;
 }
 
 void Note::setArtificialHarmonic(const ArtificialHarmonic &harmonic)
 {
-    myArtificialHarmonic = harmonic;
+    editColdProperties().myArtificialHarmonic = harmonic;
 }
 
 void Note::clearArtificialHarmonic()
 {
-    myArtificialHarmonic.reset();
+    if (myColdProperties)
+    {
+        myColdProperties->myArtificialHarmonic.reset();
+        releaseEmptyColdProperties();
+    }
 }
 
 bool Note::hasBend() const
 {
-    return myBend.has_value();
+    return getColdProperties().myBend.has_value();
 }
 
 const Bend &Note::getBend() const
 {
-    return *myBend;
+    return *getColdProperties().myBend;
 }
 
 void Note::setBend(const Bend &bend)
 {
-    myBend = bend;
+    editColdProperties().myBend = bend;
 }
 
 void Note::clearBend()
 {
-    myBend.reset();
+    if (myColdProperties)
+    {
+        myColdProperties->myBend.reset();
+        releaseEmptyColdProperties();
+    }
 }
 
 bool Note::hasLeftHandFingering() const
 {
-    return myLeftHandFingering.has_value();
+    return getColdProperties().myLeftHandFingering.has_value();
 }
 
 const LeftHandFingering &Note::getLeftHandFingering() const
 {
-    return *myLeftHandFingering;
+    return *getColdProperties().myLeftHandFingering;
 }
 
 void Note::setLeftHandFingering(const LeftHandFingering &fingering)
 {
-    myLeftHandFingering = fingering;
+    editColdProperties().myLeftHandFingering = fingering;
 }
 
 void Note::clearLeftHandFingering()
 {
-    myLeftHandFingering.reset();
+    if (myColdProperties)
+    {
+        myColdProperties->myLeftHandFingering.reset();
+        releaseEmptyColdProperties();
+    }
 }
 
 std::ostream &operator<<(std::ostream &os, const Note &note)
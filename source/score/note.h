@@ -20,8 +20,10 @@
 
 #include <bitset>
 #include "chordname.h"
+#include <cstdint>
 #include "fileversion.h"
 #include <iosfwd>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -193,6 +195,12 @@ public:
 
     Note();
     Note(int string, int fretNumber);
+    Note(const Note &other);
+    Note(Note &&other) noexcept = default;
+    ~Note();
+
+    Note &operator=(const Note &other);
+    Note &operator=(Note &&other) noexcept = default;
 
     bool operator==(const Note &other) const;
 
@@ -263,28 +271,67 @@ public:
     static const int MAX_FRET_NUMBER;
 
 private:
-    int myString;
-    int myFretNumber;
-    std::bitset<NumSimpleProperties> mySimpleProperties;
-    int myTrilledFret;
-    int myTappedHarmonicFret;
-    std::optional<ArtificialHarmonic> myArtificialHarmonic;
-    std::optional<Bend> myBend;
-    std::optional<LeftHandFingering> myLeftHandFingering;
+    /// Properties that only a small fraction of notes have. These are kept
+    /// out of line so that the common case of a plain note stays small.
+    struct ColdProperties
+    {
+        bool isEmpty() const;
+
+        int myTrilledFret = -1;
+        int myTappedHarmonicFret = -1;
+        std::optional<ArtificialHarmonic> myArtificialHarmonic;
+        std::optional<Bend> myBend;
+        std::optional<LeftHandFingering> myLeftHandFingering;
+    };
+
+    static_assert(NumSimpleProperties <= 32,
+                  "Simple properties must fit in a 32-bit mask");
+
+    /// Returns the cold properties, or a shared empty set if there are none.
+    const ColdProperties &getColdProperties() const;
+    /// Returns the cold properties for modification, allocating them if
+    /// necessary.
+    ColdProperties &editColdProperties();
+    /// Replaces the cold properties, releasing the storage if they are empty.
+    void setColdProperties(ColdProperties &&cold);
+    /// Releases the cold properties if none of them are set anymore.
+    void releaseEmptyColdProperties();
+
+    std::unique_ptr<ColdProperties> myColdProperties;
+    uint32_t mySimpleProperties;
+    int16_t myString;
+    int16_t myFretNumber;
 };
 
 template <class Archive>
 void Note::serialize(Archive &ar, const FileVersion version)
 {
-    ar("string", myString);
-    ar("fret", myFretNumber);
-    ar("properties", mySimpleProperties);
-    ar("trill", myTrilledFret);
-    ar("tapped_harmonic", myTappedHarmonicFret);
-    ar("artificial_harmonic", myArtificialHarmonic);
-    ar("bend", myBend);
+    // Read / write the same fields as the original layout of the note, so
+    // that the file format does not depend on how the note is stored.
+    int string = myString;
+    int fret = myFretNumber;
+    std::bitset<NumSimpleProperties> properties(mySimpleProperties);
+    ColdProperties cold = getColdProperties();
+
+    ar("string", string);
+    ar("fret", fret);
+    ar("properties", properties);
+    ar("trill", cold.myTrilledFret);
+    ar("tapped_harmonic", cold.myTappedHarmonicFret);
+    ar("artificial_harmonic", cold.myArtificialHarmonic);
+    ar("bend", cold.myBend);
     if (version >= FileVersion::LEFT_HAND_FINGERING)
-        ar("finger_hint", myLeftHandFingering);
+        ar("finger_hint", cold.myLeftHandFingering);
+
+    // Only modify the note when loading, since saving a const score also
+    // goes through this method.
+    if constexpr (Archive::IsLoading)
+    {
+        myString = static_cast<int16_t>(string);
+        myFretNumber = static_cast<int16_t>(fret);
+        mySimpleProperties = static_cast<uint32_t>(properties.to_ulong());
+        setColdProperties(std::move(cold));
+    }
 }
 
 /// Useful utility functions for working with natural and tapped harmonics.
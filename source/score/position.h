@@ -19,17 +19,20 @@
 #define SCORE_POSITION_H
 
 #include <algorithm>
+#include <boost/container/small_vector.hpp>
 #include <boost/range/iterator_range_core.hpp>
 #include <bitset>
 #include "fileversion.h"
 #include "note.h"
-#include <vector>
 
 class Position
 {
 public:
-    typedef std::vector<Note>::iterator NoteIterator;
-    typedef std::vector<Note>::const_iterator NoteConstIterator;
+    /// Most positions hold a single note or a small chord, so a couple of
+    /// notes are stored inline to avoid a separate heap allocation.
+    typedef boost::container::small_vector<Note, 2> NoteList;
+    typedef NoteList::iterator NoteIterator;
+    typedef NoteList::const_iterator NoteConstIterator;
 
     enum DurationType
     {
@@ -123,7 +126,7 @@ private:
     DurationType myDurationType;
     std::bitset<NumSimpleProperties> mySimpleProperties;
     int myMultiBarRestCount;
-    std::vector<Note> myNotes;
+    NoteList myNotes;
 };
 
 template <class Archive>
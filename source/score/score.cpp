@@ -20,8 +20,12 @@
 const int Score::MIN_LINE_SPACING = 6;
 const int Score::MAX_LINE_SPACING = 14;
 
-Score::Score()
-    : myLineSpacing(9)
+Score::Score() : Score(allocator_type())
+{
+}
+
+Score::Score(const allocator_type &alloc)
+    : mySystems(alloc), myLineSpacing(9)
 {
 }
 
@@ -34,6 +38,11 @@ bool Score::operator==(const Score &other) const
            myViewFilters == other.myViewFilters;
 }
 
+std::unique_ptr<Score> Score::clone() const
+{
+    return std::unique_ptr<Score>(new Score(*this));
+}
+
 const ScoreInfo &Score::getScoreInfo() const
 {
     return myScoreInfo;
@@ -67,6 +76,11 @@ void Score::removeSystem(int index)
     mySystems.erase(mySystems.begin() + index);
 }
 
+void Score::clearSystems()
+{
+    std::pmr::vector<System>(mySystems.get_allocator()).swap(mySystems);
+}
+
 boost::iterator_range<Score::PlayerIterator> Score::getPlayers()
 {
     return boost::make_iterator_range(myPlayers);
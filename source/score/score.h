@@ -25,6 +25,8 @@
 #include "scoreinfo.h"
 #include "system.h"
 #include "viewfilter.h"
+#include <memory>
+#include <memory_resource>
 #include <vector>
 
 class PlayerChange;
@@ -32,20 +34,27 @@ class PlayerChange;
 class Score
 {
 public:
-    typedef std::vector<System>::iterator SystemIterator;
-    typedef std::vector<System>::const_iterator SystemConstIterator;
+    typedef std::pmr::vector<System>::iterator SystemIterator;
+    typedef std::pmr::vector<System>::const_iterator SystemConstIterator;
     typedef std::vector<Player>::iterator PlayerIterator;
     typedef std::vector<Player>::const_iterator PlayerConstIterator;
     typedef std::vector<Instrument>::iterator InstrumentIterator;
     typedef std::vector<Instrument>::const_iterator InstrumentConstIterator;
     typedef std::vector<ViewFilter>::iterator ViewFilterIterator;
     typedef std::vector<ViewFilter>::const_iterator ViewFilterConstIterator;
+    typedef System::allocator_type allocator_type;
 
     Score();
-    Score(const Score &other) = delete;
+    /// Creates a score whose systems (and everything within them) are
+    /// allocated from the given memory resource, which must outlive the score.
+    explicit Score(const allocator_type &alloc);
     Score &operator=(const Score &other) = delete;
     bool operator==(const Score &other) const;
 
+    /// Returns a deep copy of the score, e.g. to be saved in the background
+    /// while the original continues to be edited.
+    std::unique_ptr<Score> clone() const;
+
     template <class Archive>
     void serialize(Archive &ar, const FileVersion version);
 
@@ -63,6 +72,8 @@ public:
     void insertSystem(const System &system, int index = -1);
     /// Removes the specified system from the score.
     void removeSystem(int index);
+    /// Removes all systems from the score and releases their storage.
+    void clearSystems();
 
     /// Returns the set of players in the score.
     boost::iterator_range<PlayerIterator> getPlayers();
@@ -105,9 +116,12 @@ public:
     static const int MAX_LINE_SPACING;
 
 private:
+    /// Copies are expensive, so they must be made explicitly via clone().
+    Score(const Score &other) = default;
+
     // TODO - add font settings, chord diagrams, etc.
     ScoreInfo myScoreInfo;
-    std::vector<System> mySystems;
+    std::pmr::vector<System> mySystems;
     std::vector<Player> myPlayers;
     std::vector<Instrument> myInstruments;
     int myLineSpacing; ///< Spacing between tab lines (in pixels).
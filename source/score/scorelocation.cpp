@@ -274,7 +274,18 @@ Note *ScoreLocation::getNote()
 
 std::vector<Note *> ScoreLocation::getSelectedNotes()
 {
-    std::vector<Note *> notes;
+    // Avoid duplicate logic between const and non-const versions.
+    auto notes = const_cast<const ScoreLocation *>(this)->getSelectedNotes();
+    std::vector<Note *> nc_notes;
+    for (const Note *note : notes)
+        nc_notes.push_back(const_cast<Note *>(note));
+
+    return nc_notes;
+}
+
+std::vector<const Note *> ScoreLocation::getSelectedNotes() const
+{
+    std::vector<const Note *> notes;
 
     if (!hasSelection())
     {
@@ -283,10 +294,9 @@ std::vector<Note *> ScoreLocation::getSelectedNotes()
     }
     else
     {
-        std::vector<Position *> selectedPositions(getSelectedPositions());
-        for (Position *pos : selectedPositions)
+        for (const Position *pos : getSelectedPositions())
         {
-            for (Note &note : pos->getNotes())
+            for (const Note &note : pos->getNotes())
                 notes.push_back(&note);
         }
     }
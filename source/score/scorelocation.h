@@ -86,6 +86,7 @@ public:
     const Note *getNote() const;
     Note *getNote();
     std::vector<Note *> getSelectedNotes();
+    std::vector<const Note *> getSelectedNotes() const;
 
 private:
     const Score &myScore;
@@ -23,6 +23,8 @@ namespace ScoreUtils
 {
 InputArchive::InputArchive(std::istream &is) : myStream(is)
 {
+    Tracing::Span span("InputArchive::InputArchive");
+
     if (!is)
         throw std::runtime_error("Could not open stream");
 
@@ -45,17 +47,4 @@ FileVersion InputArchive::version() const
 {
     return myVersion;
 }
-
-OutputArchive::OutputArchive(std::ostream &os, FileVersion version)
-    : myWriteStream(os), myStream(myWriteStream), myVersion(version)
-{
-    myStream.StartObject();
-
-    (*this)("version", myVersion);
-}
-
-OutputArchive::~OutputArchive()
-{
-    myStream.EndObject();
-}
 }
@@ -19,6 +19,7 @@
 #define SCORE_SERIALIZATION_H
 
 #include <array>
+#include <boost/container/small_vector.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <bitset>
 #include "fileversion.h"
@@ -26,10 +27,11 @@
 #include <optional>
 #include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
-#include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/writer.h>
 #include <stack>
 #include <stdexcept>
+#include <util/tracing.h>
 #include <variant>
 #include <vector>
 
@@ -38,6 +40,10 @@ namespace ScoreUtils
 class InputArchive
 {
 public:
+    /// Whether objects are being read from the archive, for serialize()
+    /// methods that need to convert values after loading them.
+    static constexpr bool IsLoading = true;
+
     InputArchive(std::istream &is);
 
     FileVersion version() const;
@@ -109,8 +115,11 @@ private:
     inline void read(bool &val);
     inline void read(std::string &str);
 
-    template <typename T>
-    void read(std::vector<T> &vec);
+    template <typename T, typename Alloc>
+    void read(std::vector<T, Alloc> &vec);
+
+    template <typename T, size_t N>
+    void read(boost::container::small_vector<T, N> &vec);
 
     template <typename K, typename V, typename C>
     void read(std::map<K, V, C> &map);
@@ -153,6 +162,8 @@ private:
 template <typename T>
 void load(std::istream &input, const std::string &name, T &obj)
 {
+    Tracing::Span span("ScoreUtils::load");
+
     InputArchive archive(input);
     if (archive.version() > FileVersion::LATEST_VERSION ||
         archive.version() < FileVersion::INITIAL_VERSION)
@@ -163,11 +174,45 @@ void load(std::istream &input, const std::string &name, T &obj)
     archive(name, obj);
 }
 
-class OutputArchive
+/// A rapidjson output stream that writes to a std::ostream in large chunks,
+/// rather than one character at a time like rapidjson::OStreamWrapper.
+class BufferedOStream
+{
+public:
+    typedef char Ch;
+
+    explicit BufferedOStream(std::ostream &os) : myOutput(os), mySize(0)
+    {
+    }
+
+    void Put(char c)
+    {
+        if (mySize == myBuffer.size())
+            Flush();
+
+        myBuffer[mySize++] = c;
+    }
+
+    void Flush()
+    {
+        myOutput.write(myBuffer.data(), static_cast<std::streamsize>(mySize));
+        mySize = 0;
+    }
+
+private:
+    std::ostream &myOutput;
+    std::array<char, 16384> myBuffer;
+    size_t mySize;
+};
+
+template <typename Writer>
+class BasicOutputArchive
 {
 public:
-    OutputArchive(std::ostream &os, FileVersion version);
-    ~OutputArchive();
+    static constexpr bool IsLoading = false;
+
+    BasicOutputArchive(std::ostream &os, FileVersion version);
+    ~BasicOutputArchive();
 
     template <typename T>
     void operator()(const std::string &name, const T &obj)
@@ -177,13 +222,16 @@ public:
     }
 
 private:
-    inline void write(int val);
-    inline void write(unsigned int val);
-    inline void write(bool val);
-    inline void write(const std::string &str);
+    void write(int val);
+    void write(unsigned int val);
+    void write(bool val);
+    void write(const std::string &str);
 
-    template <typename T>
-    void write(const std::vector<T> &vec);
+    template <typename T, typename Alloc>
+    void write(const std::vector<T, Alloc> &vec);
+
+    template <typename T, size_t N>
+    void write(const boost::container::small_vector<T, N> &vec);
 
     template <typename K, typename V, typename C>
     void write(const std::map<K, V, C> &map);
@@ -197,7 +245,7 @@ private:
     template <typename T>
     void write(const std::optional<T> &val);
 
-    inline void write(const boost::gregorian::date &date);
+    void write(const boost::gregorian::date &date);
 
     template <typename T>
     typename std::enable_if<std::is_enum<T>::value>::type write(const T &val)
@@ -213,16 +261,38 @@ private:
         myStream.EndObject();
     }
 
-    rapidjson::OStreamWrapper myWriteStream;
-    rapidjson::PrettyWriter<rapidjson::OStreamWrapper> myStream;
+    BufferedOStream myWriteStream;
+    Writer myStream;
     const FileVersion myVersion;
 };
 
+/// Writes indented JSON, which is easier to read and diff.
+typedef BasicOutputArchive<rapidjson::PrettyWriter<BufferedOStream>>
+    OutputArchive;
+/// Writes JSON without any whitespace, which is smaller and faster to write.
+typedef BasicOutputArchive<rapidjson::Writer<BufferedOStream>>
+    CompactOutputArchive;
+
+enum class OutputFormat
+{
+    Pretty,
+    Compact
+};
+
 template <typename T>
-void save(std::ostream &output, const std::string &name, const T &obj)
+void save(std::ostream &output, const std::string &name, const T &obj,
+          OutputFormat format = OutputFormat::Pretty)
 {
-    OutputArchive ar(output, FileVersion::LATEST_VERSION);
-    ar(name, obj);
+    if (format == OutputFormat::Compact)
+    {
+        CompactOutputArchive ar(output, FileVersion::LATEST_VERSION);
+        ar(name, obj);
+    }
+    else
+    {
+        OutputArchive ar(output, FileVersion::LATEST_VERSION);
+        ar(name, obj);
+    }
 }
 
 void InputArchive::read(int &val)
@@ -261,8 +331,24 @@ void InputArchive::read(std::string &str)
     str = value().GetString();
 }
 
-template <typename T>
-void InputArchive::read(std::vector<T> &vec)
+template <typename T, typename Alloc>
+void InputArchive::read(std::vector<T, Alloc> &vec)
+{
+    auto size = value().Size();
+    myIterators.push(value().Begin());
+
+    vec.resize(size);
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        read(vec[i]);
+        advance();
+    }
+
+    myIterators.pop();
+}
+
+template <typename T, size_t N>
+void InputArchive::read(boost::container::small_vector<T, N> &vec)
 {
     auto size = value().Size();
     myIterators.push(value().Begin());
@@ -339,29 +425,62 @@ void InputArchive::read(boost::gregorian::date &date)
     date = boost::gregorian::from_undelimited_string(date_str);
 }
 
-void OutputArchive::write(int val)
+template <typename Writer>
+BasicOutputArchive<Writer>::BasicOutputArchive(std::ostream &os,
+                                               FileVersion version)
+    : myWriteStream(os), myStream(myWriteStream), myVersion(version)
+{
+    myStream.StartObject();
+
+    (*this)("version", myVersion);
+}
+
+template <typename Writer>
+BasicOutputArchive<Writer>::~BasicOutputArchive()
+{
+    myStream.EndObject();
+    myWriteStream.Flush();
+}
+
+template <typename Writer>
+void BasicOutputArchive<Writer>::write(int val)
 {
     myStream.Int(val);
 }
 
-void OutputArchive::write(unsigned int val)
+template <typename Writer>
+void BasicOutputArchive<Writer>::write(unsigned int val)
 {
     myStream.Uint(val);
 }
 
-void OutputArchive::write(bool val)
+template <typename Writer>
+void BasicOutputArchive<Writer>::write(bool val)
 {
     myStream.Bool(val);
 }
 
-void OutputArchive::write(const std::string &str)
+template <typename Writer>
+void BasicOutputArchive<Writer>::write(const std::string &str)
 {
     myStream.String(str.c_str(),
                     static_cast<rapidjson::SizeType>(str.length()));
 }
 
-template <typename T>
-void OutputArchive::write(const std::vector<T> &vec)
+template <typename Writer>
+template <typename T, typename Alloc>
+void BasicOutputArchive<Writer>::write(const std::vector<T, Alloc> &vec)
+{
+    myStream.StartArray();
+    for (const T &obj : vec)
+        write(obj);
+    myStream.EndArray();
+}
+
+template <typename Writer>
+template <typename T, size_t N>
+void BasicOutputArchive<Writer>::write(
+    const boost::container::small_vector<T, N> &vec)
 {
     myStream.StartArray();
     for (const T &obj : vec)
@@ -369,8 +488,9 @@ void OutputArchive::write(const std::vector<T> &vec)
     myStream.EndArray();
 }
 
+template <typename Writer>
 template <typename K, typename V, typename C>
-void OutputArchive::write(const std::map<K, V, C> &map)
+void BasicOutputArchive<Writer>::write(const std::map<K, V, C> &map)
 {
     myStream.StartObject();
 
@@ -380,8 +500,9 @@ void OutputArchive::write(const std::map<K, V, C> &map)
     myStream.EndObject();
 }
 
+template <typename Writer>
 template <typename T, size_t N>
-void OutputArchive::write(const std::array<T, N> &arr)
+void BasicOutputArchive<Writer>::write(const std::array<T, N> &arr)
 {
     myStream.StartObject();
 
@@ -391,14 +512,16 @@ void OutputArchive::write(const std::array<T, N> &arr)
     myStream.EndObject();
 }
 
+template <typename Writer>
 template <size_t N>
-void OutputArchive::write(const std::bitset<N> &bits)
+void BasicOutputArchive<Writer>::write(const std::bitset<N> &bits)
 {
     write(bits.to_string());
 }
 
+template <typename Writer>
 template <typename T>
-void OutputArchive::write(const std::optional<T> &val)
+void BasicOutputArchive<Writer>::write(const std::optional<T> &val)
 {
     if (val)
         write(*val);
@@ -406,7 +529,8 @@ void OutputArchive::write(const std::optional<T> &val)
         myStream.Null();
 }
 
-void OutputArchive::write(const boost::gregorian::date &date)
+template <typename Writer>
+void BasicOutputArchive<Writer>::write(const boost::gregorian::date &date)
 {
     write(boost::gregorian::to_iso_string(date));
 }
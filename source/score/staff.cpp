@@ -19,12 +19,44 @@
 
 #include "utils.h"
 
-Staff::Staff() : myClefType(TrebleClef), myStringCount(6)
+// std::array is not allocator-aware, so each voice is constructed explicitly.
+static_assert(Staff::NUM_VOICES == 2, "Update the voice initializers");
+
+Staff::Staff() : Staff(6)
+{
+}
+
+Staff::Staff(int stringCount) : Staff(stringCount, allocator_type())
+{
+}
+
+Staff::Staff(const allocator_type &alloc) : Staff(6, alloc)
+{
+}
+
+Staff::Staff(int stringCount, const allocator_type &alloc)
+    : myClefType(TrebleClef),
+      myStringCount(stringCount),
+      myVoices{{Voice(alloc), Voice(alloc)}},
+      myDynamics(alloc)
+{
+}
+
+Staff::Staff(const Staff &other, const allocator_type &alloc)
+    : myClefType(other.myClefType),
+      myStringCount(other.myStringCount),
+      myVoices{{Voice(other.myVoices[0], alloc),
+                Voice(other.myVoices[1], alloc)}},
+      myDynamics(other.myDynamics, alloc)
 {
 }
 
-Staff::Staff(int stringCount)
-    : myClefType(TrebleClef), myStringCount(stringCount)
+Staff::Staff(Staff &&other, const allocator_type &alloc)
+    : myClefType(other.myClefType),
+      myStringCount(other.myStringCount),
+      myVoices{{Voice(std::move(other.myVoices[0]), alloc),
+                Voice(std::move(other.myVoices[1]), alloc)}},
+      myDynamics(std::move(other.myDynamics), alloc)
 {
 }
 
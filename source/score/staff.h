@@ -22,6 +22,7 @@
 #include <boost/range/iterator_range_core.hpp>
 #include "dynamic.h"
 #include "fileversion.h"
+#include <memory_resource>
 #include <vector>
 #include "voice.h"
 
@@ -42,11 +43,21 @@ public:
     typedef std::array<Voice, NUM_VOICES> VoiceList;
     typedef VoiceList::iterator VoiceIterator;
     typedef VoiceList::const_iterator VoiceConstIterator;
-    typedef std::vector<Dynamic>::iterator DynamicIterator;
-    typedef std::vector<Dynamic>::const_iterator DynamicConstIterator;
+    typedef std::pmr::vector<Dynamic>::iterator DynamicIterator;
+    typedef std::pmr::vector<Dynamic>::const_iterator DynamicConstIterator;
+    typedef Voice::allocator_type allocator_type;
 
     Staff();
     explicit Staff(int stringCount);
+    explicit Staff(const allocator_type &alloc);
+    Staff(int stringCount, const allocator_type &alloc);
+    Staff(const Staff &other) = default;
+    Staff(const Staff &other, const allocator_type &alloc);
+    Staff(Staff &&other) noexcept = default;
+    Staff(Staff &&other, const allocator_type &alloc);
+
+    Staff &operator=(const Staff &other) = default;
+    Staff &operator=(Staff &&other) = default;
 
     bool operator==(const Staff &other) const;
 
@@ -83,7 +94,7 @@ private:
     ClefType myClefType;
     int myStringCount;
     std::array<Voice, NUM_VOICES> myVoices;
-    std::vector<Dynamic> myDynamics;
+    std::pmr::vector<Dynamic> myDynamics;
 };
 
 template <class Archive>
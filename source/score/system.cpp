@@ -22,7 +22,19 @@
 #include <cstddef>
 #include "utils.h"
 
-System::System()
+System::System() : System(allocator_type())
+{
+}
+
+System::System(const allocator_type &alloc)
+    : myStaves(alloc),
+      myBarlines(alloc),
+      myTempoMarkers(alloc),
+      myAlternateEndings(alloc),
+      myDirections(alloc),
+      myPlayerChanges(alloc),
+      myChords(alloc),
+      myTextItems(alloc)
 {
     // Add the start and end bars.
     myBarlines.push_back(Barline());
@@ -31,6 +43,30 @@ System::System()
     myBarlines.push_back(endBar);
 }
 
+System::System(const System &other, const allocator_type &alloc)
+    : myStaves(other.myStaves, alloc),
+      myBarlines(other.myBarlines, alloc),
+      myTempoMarkers(other.myTempoMarkers, alloc),
+      myAlternateEndings(other.myAlternateEndings, alloc),
+      myDirections(other.myDirections, alloc),
+      myPlayerChanges(other.myPlayerChanges, alloc),
+      myChords(other.myChords, alloc),
+      myTextItems(other.myTextItems, alloc)
+{
+}
+
+System::System(System &&other, const allocator_type &alloc)
+    : myStaves(std::move(other.myStaves), alloc),
+      myBarlines(std::move(other.myBarlines), alloc),
+      myTempoMarkers(std::move(other.myTempoMarkers), alloc),
+      myAlternateEndings(std::move(other.myAlternateEndings), alloc),
+      myDirections(std::move(other.myDirections), alloc),
+      myPlayerChanges(std::move(other.myPlayerChanges), alloc),
+      myChords(std::move(other.myChords), alloc),
+      myTextItems(std::move(other.myTextItems), alloc)
+{
+}
+
 bool System::operator==(const System &other) const
 {
     return myStaves == other.myStaves && myBarlines == other.myBarlines &&
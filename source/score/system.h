@@ -24,6 +24,7 @@
 #include "chordtext.h"
 #include "direction.h"
 #include "fileversion.h"
+#include <memory_resource>
 #include "playerchange.h"
 #include "staff.h"
 #include "tempomarker.h"
@@ -33,24 +34,34 @@
 class System
 {
 public:
-    typedef std::vector<Staff>::iterator StaffIterator;
-    typedef std::vector<Staff>::const_iterator StaffConstIterator;
-    typedef std::vector<Barline>::iterator BarlineIterator;
-    typedef std::vector<Barline>::const_iterator BarlineConstIterator;
-    typedef std::vector<TempoMarker>::iterator TempoMarkerIterator;
-    typedef std::vector<TempoMarker>::const_iterator TempoMarkerConstIterator;
-    typedef std::vector<AlternateEnding>::iterator AlternateEndingIterator;
-    typedef std::vector<AlternateEnding>::const_iterator AlternateEndingConstIterator;
-    typedef std::vector<Direction>::iterator DirectionIterator;
-    typedef std::vector<Direction>::const_iterator DirectionConstIterator;
-    typedef std::vector<PlayerChange>::iterator PlayerChangeIterator;
-    typedef std::vector<PlayerChange>::const_iterator PlayerChangeConstIterator;
-    typedef std::vector<ChordText>::iterator ChordTextIterator;
-    typedef std::vector<ChordText>::const_iterator ChordTextConstIterator;
-    typedef std::vector<TextItem>::iterator TextItemIterator;
-    typedef std::vector<TextItem>::const_iterator TextItemConstIterator;
+    typedef std::pmr::vector<Staff>::iterator StaffIterator;
+    typedef std::pmr::vector<Staff>::const_iterator StaffConstIterator;
+    typedef std::pmr::vector<Barline>::iterator BarlineIterator;
+    typedef std::pmr::vector<Barline>::const_iterator BarlineConstIterator;
+    typedef std::pmr::vector<TempoMarker>::iterator TempoMarkerIterator;
+    typedef std::pmr::vector<TempoMarker>::const_iterator TempoMarkerConstIterator;
+    typedef std::pmr::vector<AlternateEnding>::iterator AlternateEndingIterator;
+    typedef std::pmr::vector<AlternateEnding>::const_iterator AlternateEndingConstIterator;
+    typedef std::pmr::vector<Direction>::iterator DirectionIterator;
+    typedef std::pmr::vector<Direction>::const_iterator DirectionConstIterator;
+    typedef std::pmr::vector<PlayerChange>::iterator PlayerChangeIterator;
+    typedef std::pmr::vector<PlayerChange>::const_iterator PlayerChangeConstIterator;
+    typedef std::pmr::vector<ChordText>::iterator ChordTextIterator;
+    typedef std::pmr::vector<ChordText>::const_iterator ChordTextConstIterator;
+    typedef std::pmr::vector<TextItem>::iterator TextItemIterator;
+    typedef std::pmr::vector<TextItem>::const_iterator TextItemConstIterator;
+
+    typedef Staff::allocator_type allocator_type;
 
     System();
+    explicit System(const allocator_type &alloc);
+    System(const System &other) = default;
+    System(const System &other, const allocator_type &alloc);
+    System(System &&other) noexcept = default;
+    System(System &&other, const allocator_type &alloc);
+
+    System &operator=(const System &other) = default;
+    System &operator=(System &&other) = default;
 
     bool operator==(const System &other) const;
 
@@ -145,16 +156,16 @@ public:
     void removeTextItem(const TextItem &text);
 
 private:
-    std::vector<Staff> myStaves;
+    std::pmr::vector<Staff> myStaves;
     /// List of the barlines in the system. This will always contain at least
     /// two barlines - the start and end bars.
-    std::vector<Barline> myBarlines;
-    std::vector<TempoMarker> myTempoMarkers;
-    std::vector<AlternateEnding> myAlternateEndings;
-    std::vector<Direction> myDirections;
-    std::vector<PlayerChange> myPlayerChanges;
-    std::vector<ChordText> myChords;
-    std::vector<TextItem> myTextItems;
+    std::pmr::vector<Barline> myBarlines;
+    std::pmr::vector<TempoMarker> myTempoMarkers;
+    std::pmr::vector<AlternateEnding> myAlternateEndings;
+    std::pmr::vector<Direction> myDirections;
+    std::pmr::vector<PlayerChange> myPlayerChanges;
+    std::pmr::vector<ChordText> myChords;
+    std::pmr::vector<TextItem> myTextItems;
 };
 
 template <class Archive>
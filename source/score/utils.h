@@ -90,8 +90,8 @@ namespace ScoreUtils {
         }
     };
 
-    template <typename T>
-    void insertObject(std::vector<T> &objects, const T &obj)
+    template <typename T, typename Alloc>
+    void insertObject(std::vector<T, Alloc> &objects, const T &obj)
     {
         // Avoid sorting unless we actually need to. This improves performance
         // quite a bit when, for example, we are importing from other file
@@ -104,8 +104,8 @@ namespace ScoreUtils {
             std::sort(objects.begin(), objects.end(), OrderByPosition<T>());
     }
 
-    template <typename T>
-    void removeObject(std::vector<T> &objects, const T &obj)
+    template <typename T, typename Alloc>
+    void removeObject(std::vector<T, Alloc> &objects, const T &obj)
     {
         objects.erase(std::remove(objects.begin(), objects.end(), obj),
                       objects.end());
@@ -0,0 +1,102 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "barindex.h"
+
+#include <algorithm>
+#include <score/score.h>
+
+BarIndex::BarIndex(const Score &score) : myScore(score)
+{
+    rebuild();
+}
+
+void BarIndex::invalidate(int system)
+{
+    const int numSystems = static_cast<int>(myScore.getSystems().size());
+    system = std::clamp(system, 0,
+                        std::min(numSystems,
+                                 static_cast<int>(myFirstBars.size()) - 1));
+
+    myFirstBars.resize(numSystems + 1);
+    for (int i = system; i < numSystems; ++i)
+    {
+        const System &s = myScore.getSystems()[i];
+        myFirstBars[i + 1] =
+            myFirstBars[i] + static_cast<int>(s.getBarlines().size()) - 1;
+    }
+}
+
+void BarIndex::rebuild()
+{
+    myFirstBars.assign(1, 0);
+    invalidate(0);
+}
+
+int BarIndex::getBarCount() const
+{
+    return myFirstBars.back();
+}
+
+int BarIndex::getFirstBar(int system) const
+{
+    return myFirstBars.at(system);
+}
+
+BarIndex::Bar BarIndex::getBar(int bar) const
+{
+    if (bar < 0 || bar >= getBarCount())
+        throw std::out_of_range("Invalid bar number");
+
+    // Find the last system that starts at or before the bar. Systems without
+    // any bars share the same starting bar number, so upper_bound skips them.
+    auto it = std::upper_bound(myFirstBars.begin(), myFirstBars.end(), bar);
+    const int systemIndex =
+        static_cast<int>(std::distance(myFirstBars.begin(), it)) - 1;
+
+    const System &system = myScore.getSystems()[systemIndex];
+    const int barline = bar - myFirstBars[systemIndex];
+
+    return { systemIndex, barline, system.getBarlines()[barline].getPosition(),
+             system.getBarlines()[barline + 1].getPosition() };
+}
+
+int BarIndex::findBar(int system, int position) const
+{
+    auto barlines = myScore.getSystems()[system].getBarlines();
+
+    // Find the last barline (other than the end bar) at or before the
+    // position.
+    auto it = std::upper_bound(
+        barlines.begin(), barlines.end() - 1, position,
+        [](int pos, const Barline &bar) { return pos < bar.getPosition(); });
+    const int barline =
+        std::max(0, static_cast<int>(std::distance(barlines.begin(), it)) - 1);
+
+    return getFirstBar(system) + barline;
+}
+
+boost::rational<int> BarIndex::getDuration(int bar) const
+{
+    const Bar location = getBar(bar);
+    const TimeSignature &timeSig = myScore.getSystems()[location.mySystem]
+                                       .getBarlines()[location.myBarline]
+                                       .getTimeSignature();
+
+    return timeSig.getBeatsPerMeasure() *
+           boost::rational<int>(4, timeSig.getBeatValue());
+}
@@ -0,0 +1,73 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCORE_UTILS_BARINDEX_H
+#define SCORE_UTILS_BARINDEX_H
+
+#include <boost/rational.hpp>
+#include <vector>
+
+class Score;
+
+/// Maintains the number of bars before each system in the score, so that
+/// score-wide bar numbers can be looked up without walking every system.
+/// Bars are numbered from zero across the whole score.
+class BarIndex
+{
+public:
+    /// The location of a bar within the score.
+    struct Bar
+    {
+        int mySystem;
+        /// Index of the bar's starting barline within the system.
+        int myBarline;
+        /// The bar spans the positions [myStartPosition, myEndPosition).
+        int myStartPosition;
+        int myEndPosition;
+    };
+
+    explicit BarIndex(const Score &score);
+
+    /// Updates the index after the given system was modified. This must also
+    /// be called with the first affected index when systems are inserted or
+    /// removed. This only takes time proportional to the number of following
+    /// systems.
+    void invalidate(int system);
+    /// Rebuilds the entire index.
+    void rebuild();
+
+    /// Returns the total number of bars in the score.
+    int getBarCount() const;
+    /// Returns the number of the first bar in the system.
+    int getFirstBar(int system) const;
+    /// Returns the location of the nth bar in the score, in O(log n) time.
+    Bar getBar(int bar) const;
+    /// Returns the number of the bar containing the given position, in
+    /// O(log n) time.
+    int findBar(int system, int position) const;
+    /// Returns the nominal duration of the bar in quarter notes (e.g. 3 for
+    /// 6/8) according to its time signature.
+    boost::rational<int> getDuration(int bar) const;
+
+private:
+    const Score &myScore;
+    /// The number of bars before each system, followed by the total number of
+    /// bars.
+    std::vector<int> myFirstBars;
+};
+
+#endif
@@ -17,19 +17,20 @@
 
 #include "scoremerger.h"
 
-#include <list>
+#include <algorithm>
+#include <future>
 #include <unordered_set>
+#include <vector>
 
-#include <app/caret.h>
-#include <app/viewoptions.h>
 #include <score/score.h>
+#include <score/scorelocation.h>
 #include <score/systemlocation.h>
 #include <score/utils.h>
 #include <score/utils/repeatindexer.h>
 #include <score/voiceutils.h>
+#include <util/tracing.h>
 
 static const int thePositionLimit = 30;
-static const ViewOptions theDefaultViewOptions;
 
 class ExpandedBar
 {
@@ -43,7 +44,8 @@ public:
           myStartBar(start_bar),
           myRemainingRepeats(remaining_repeats),
           myRepeatEnd(is_repeat_end),
-          myAlternateEnding(is_alt_ending)
+          myAlternateEnding(is_alt_ending),
+          myIsRemoved(false)
     {
     }
 
@@ -71,6 +73,9 @@ public:
         myAlternateEnding = false;
     }
 
+    bool isRemoved() const { return myIsRemoved; }
+    void markRemoved() { myIsRemoved = true; }
+
 private:
     SystemLocation myLocation;
 
@@ -93,33 +98,59 @@ private:
 
     /// Whether the bar is part of an alternate ending.
     bool myAlternateEnding;
+
+    /// Whether the bar was dropped when collapsing a repeated section. Removed
+    /// bars are skipped over and then erased in bulk, rather than erasing each
+    /// bar from the middle of the list.
+    bool myIsRemoved;
 };
 
-typedef std::list<ExpandedBar> ExpandedBarList;
+typedef std::vector<ExpandedBar> ExpandedBarList;
+
+/// Returns the index of the bar in the system that contains the given
+/// position.
+static int findBarIndex(const System &system, int position)
+{
+    const auto barlines = system.getBarlines();
+    // There must be at least one position space to the left of the last bar.
+    position = std::clamp(position, 0, barlines.back().getPosition() - 1);
+
+    int bar_idx = 0;
+    for (int i = 0; i < static_cast<int>(barlines.size()); ++i)
+    {
+        if (barlines[i].getPosition() <= position)
+            bar_idx = i;
+    }
 
-static void expandScore(Score &score, ExpandedBarList &expanded_bars)
+    return bar_idx;
+}
+
+/// Walks through the score in playback order (following repeats), recording
+/// each bar that is played.
+static ExpandedBarList expandScore(const Score &score)
 {
-    Caret caret(score, theDefaultViewOptions);
+    ExpandedBarList expanded_bars;
+    if (score.getSystems().empty())
+        return expanded_bars;
+
     RepeatIndexer repeat_index(score);
     int remaining_repeats = 0;
     bool alternate_ending = false;
 
+    const int num_systems = static_cast<int>(score.getSystems().size());
+    int system_idx = 0;
+    int bar_idx = 0;
+
     while (true)
     {
-        const ScoreLocation &score_loc = caret.getLocation();
-        const System &system = score_loc.getSystem();
-        const Barline *prev_bar =
-            system.getPreviousBarline(score_loc.getPositionIndex() + 1);
-        const Barline *next_bar =
-            system.getNextBarline(score_loc.getPositionIndex());
-
-        // Ensure that the caret is actually at the start of the bar.
-        caret.moveToPosition(prev_bar->getPosition());
+        const System &system = score.getSystems()[system_idx];
+        const Barline *prev_bar = &system.getBarlines()[bar_idx];
+        const Barline *next_bar = &system.getBarlines()[bar_idx + 1];
 
-        const SystemLocation location(score_loc.getSystemIndex(),
-                                      score_loc.getPositionIndex());
-        const SystemLocation next_bar_loc(location.getSystem(),
-                                          next_bar->getPosition());
+        const SystemLocation location(system_idx, prev_bar->getPosition());
+        const SystemLocation next_bar_loc(system_idx, next_bar->getPosition());
+        const ScoreLocation score_loc(score, system_idx, 0,
+                                      prev_bar->getPosition());
 
         RepeatedSection *active_repeat = repeat_index.findRepeat(next_bar_loc);
         if (active_repeat)
@@ -168,8 +199,9 @@ static void expandScore(Score &score, ExpandedBarList &expanded_bars)
             SystemLocation new_loc = active_repeat->performRepeat(next_bar_loc);
             if (new_loc != next_bar_loc)
             {
-                caret.moveToSystem(new_loc.getSystem(), false);
-                caret.moveToPosition(new_loc.getPosition());
+                system_idx = std::clamp(new_loc.getSystem(), 0, num_systems - 1);
+                bar_idx = findBarIndex(score.getSystems()[system_idx],
+                                       new_loc.getPosition());
 
                 if (next_bar->getBarType() == Barline::RepeatEnd)
                 {
@@ -187,11 +219,57 @@ static void expandScore(Score &score, ExpandedBarList &expanded_bars)
         }
 
         // Otherwise, advance to the next bar.
-        if (!caret.moveToNextBar())
+        if (bar_idx + 2 < static_cast<int>(system.getBarlines().size()))
+            ++bar_idx;
+        else if (system_idx + 1 < num_systems)
+        {
+            ++system_idx;
+            bar_idx = 0;
+        }
+        else
             break;
     }
+
+    return expanded_bars;
 }
 
+/// Provides the active players at any location in a source score. This avoids
+/// searching through all of the previous systems for each bar that is merged.
+class PlayerChangeIndex
+{
+public:
+    explicit PlayerChangeIndex(const Score &score) : myScore(score)
+    {
+        const PlayerChange *last_change = nullptr;
+        for (const System &system : score.getSystems())
+        {
+            myPreviousChanges.push_back(last_change);
+
+            if (!system.getPlayerChanges().empty())
+                last_change = &system.getPlayerChanges().back();
+        }
+    }
+
+    /// Equivalent to ScoreUtils::getCurrentPlayers().
+    const PlayerChange *getCurrentPlayers(int system, int position) const
+    {
+        const PlayerChange *last_change = myPreviousChanges[system];
+        for (const PlayerChange &change :
+             myScore.getSystems()[system].getPlayerChanges())
+        {
+            if (change.getPosition() <= position)
+                last_change = &change;
+        }
+
+        return last_change;
+    }
+
+private:
+    const Score &myScore;
+    /// For each system, the last player change from the previous systems.
+    std::vector<const PlayerChange *> myPreviousChanges;
+};
+
 static void mergePlayers(Score &dest_score, const Score &guitar_score,
                          const Score &bass_score)
 {
@@ -340,10 +418,10 @@ static int importNotes(
 
 template <typename Symbol>
 static void copySymbols(
-    const boost::iterator_range<typename std::vector<Symbol>::const_iterator> &
+    const boost::iterator_range<typename std::pmr::vector<Symbol>::const_iterator> &
         src_symbols,
     System &dest_system,
-    const boost::iterator_range<typename std::vector<Symbol>::const_iterator> &
+    const boost::iterator_range<typename std::pmr::vector<Symbol>::const_iterator> &
         dest_symbols,
     void (System::*add_symbol)(const Symbol &), int offset, int left, int right)
 {
@@ -400,13 +478,18 @@ static void mergeSystemSymbols(ScoreLocation &dest_loc,
     }
 }
 
+/// Moves the location to the start of the source bar.
+static void moveToBar(ScoreLocation &location, const ExpandedBar &bar)
+{
+    location.setSystemIndex(bar.getLocation().getSystem());
+    location.setPositionIndex(bar.getLocation().getPosition());
+}
+
 static int copyContent(ScoreLocation &dest_loc, int &num_guitar_staves,
-                       Caret &src_caret, const ExpandedBar &src_bar,
+                       ScoreLocation &src_loc, const ExpandedBar &src_bar,
                        bool is_bass)
 {
-    src_caret.moveToSystem(src_bar.getLocation().getSystem(), false);
-    src_caret.moveToPosition(src_bar.getLocation().getPosition());
-    ScoreLocation &src_loc = src_caret.getLocation();
+    moveToBar(src_loc, src_bar);
 
     mergeSystemSymbols(dest_loc, src_loc, src_bar);
 
@@ -425,12 +508,11 @@ static int copyContent(ScoreLocation &dest_loc, int &num_guitar_staves,
     }
 }
 
-static const PlayerChange *findPlayerChange(
-    const ScoreLocation &dest_loc, const ScoreLocation &src_loc,
-    ExpandedBarList::const_iterator src_bar,
-    ExpandedBarList::const_iterator end_src_bar)
+static const PlayerChange *findPlayerChange(const ScoreLocation &dest_loc,
+                                            const ScoreLocation &src_loc,
+                                            const ExpandedBar *src_bar)
 {
-    if (src_bar == end_src_bar || src_bar->isExpanded())
+    if (!src_bar || src_bar->isExpanded())
         return nullptr;
 
     int offset, left, right;
@@ -444,19 +526,19 @@ static const PlayerChange *findPlayerChange(
 
 static void mergePlayerChanges(ScoreLocation &dest_loc,
                                const ScoreLocation &guitar_loc,
+                               const PlayerChangeIndex &guitar_players,
+                               const ExpandedBar *guitar_bar,
                                const ScoreLocation &bass_loc,
-                               ExpandedBarList::const_iterator guitar_bar,
-                               ExpandedBarList::const_iterator end_guitar_bar,
-                               ExpandedBarList::const_iterator bass_bar,
-                               ExpandedBarList::const_iterator end_bass_bar,
+                               const PlayerChangeIndex &bass_players,
+                               const ExpandedBar *bass_bar,
                                int num_guitar_staves,
                                int prev_num_guitar_staves)
 {
     System &dest_system = dest_loc.getSystem();
     const PlayerChange *guitar_change =
-        findPlayerChange(dest_loc, guitar_loc, guitar_bar, end_guitar_bar);
+        findPlayerChange(dest_loc, guitar_loc, guitar_bar);
     const PlayerChange *bass_change =
-        findPlayerChange(dest_loc, bass_loc, bass_bar, end_bass_bar);
+        findPlayerChange(dest_loc, bass_loc, bass_bar);
 
     // If either the guitar or bass score has a player change, or we're in a
     // system that has a different number of guitar staves, insert a player
@@ -467,22 +549,20 @@ static void mergePlayerChanges(ScoreLocation &dest_loc,
     {
         PlayerChange change;
 
-        if (!guitar_change && guitar_bar != end_guitar_bar)
+        if (!guitar_change && guitar_bar)
         {
             // If there is only a player change in the bass score, carry over
             // the current active players from the guitar score.
-            guitar_change = ScoreUtils::getCurrentPlayers(
-                guitar_loc.getScore(), guitar_loc.getSystemIndex(),
-                guitar_loc.getPositionIndex());
+            guitar_change = guitar_players.getCurrentPlayers(
+                guitar_loc.getSystemIndex(), guitar_loc.getPositionIndex());
         }
 
-        if (!bass_change && bass_bar != end_bass_bar)
+        if (!bass_change && bass_bar)
         {
             // If there is only a player change in the guitar score, carry over
             // the current active players from the bass score.
-            bass_change = ScoreUtils::getCurrentPlayers(
-                bass_loc.getScore(), bass_loc.getSystemIndex(),
-                bass_loc.getPositionIndex());
+            bass_change = bass_players.getCurrentPlayers(
+                bass_loc.getSystemIndex(), bass_loc.getPositionIndex());
         }
 
         // Merge in data from only the active staves.
@@ -550,17 +630,14 @@ static void hideSignaturesAndRehearsalSign(Barline &bar)
 /// reordered). In such cases it is preferable to just move to a new system in
 /// the destination score.
 static bool areStavesIncompatible(const ScoreLocation &dest_loc,
-                                  Caret &src_caret,
-                                  ExpandedBarList::const_iterator src_bar,
-                                  ExpandedBarList::const_iterator end_src_bar,
-                                  int staff_begin, int staff_end)
+                                  ScoreLocation &src_loc,
+                                  const ExpandedBar *src_bar, int staff_begin,
+                                  int staff_end)
 {
-    if (src_bar == end_src_bar)
+    if (!src_bar)
         return false;
 
-    src_caret.moveToSystem(src_bar->getLocation().getSystem(), false);
-    src_caret.moveToPosition(src_bar->getLocation().getPosition());
-    const ScoreLocation &src_loc = src_caret.getLocation();
+    moveToBar(src_loc, *src_bar);
 
     const System &dest_system = dest_loc.getSystem();
     const System &src_system = src_loc.getSystem();
@@ -579,16 +656,16 @@ static bool areStavesIncompatible(const ScoreLocation &dest_loc,
     return false;
 }
 
-static bool areStavesIncompatible(
-    const ScoreLocation &dest_loc, Caret &guitar_caret, Caret &bass_caret,
-    ExpandedBarList::const_iterator guitar_bar,
-    ExpandedBarList::const_iterator end_guitar_bar,
-    ExpandedBarList::const_iterator bass_bar,
-    ExpandedBarList::const_iterator end_bass_bar, int num_guitar_staves)
+static bool areStavesIncompatible(const ScoreLocation &dest_loc,
+                                  ScoreLocation &guitar_loc,
+                                  const ExpandedBar *guitar_bar,
+                                  ScoreLocation &bass_loc,
+                                  const ExpandedBar *bass_bar,
+                                  int num_guitar_staves)
 {
-    return areStavesIncompatible(dest_loc, guitar_caret, guitar_bar,
-                                 end_guitar_bar, 0, num_guitar_staves) ||
-           areStavesIncompatible(dest_loc, bass_caret, bass_bar, end_bass_bar,
+    return areStavesIncompatible(dest_loc, guitar_loc, guitar_bar, 0,
+                                 num_guitar_staves) ||
+           areStavesIncompatible(dest_loc, bass_loc, bass_bar,
                                  num_guitar_staves,
                                  dest_loc.getSystem().getStaves().size());
 }
@@ -603,6 +680,13 @@ static void insertNewSystem(Score &score)
     score.insertSystem(system);
 }
 
+/// Returns the bar at the given index, or null if the end of the list was
+/// reached.
+static const ExpandedBar *getBar(const ExpandedBarList &bars, size_t index)
+{
+    return index < bars.size() ? &bars[index] : nullptr;
+}
+
 static void combineScores(Score &dest_score, Score &guitar_score,
                           const ExpandedBarList &guitar_bars, Score &bass_score,
                           const ExpandedBarList &bass_bars)
@@ -613,29 +697,30 @@ static void combineScores(Score &dest_score, Score &guitar_score,
     int prev_num_guitar_staves = 0;
 
     insertNewSystem(dest_score);
-    Caret dest_caret(dest_score, theDefaultViewOptions);
-    ScoreLocation &dest_loc = dest_caret.getLocation();
+    ScoreLocation dest_loc(dest_score);
 
-    Caret guitar_caret(guitar_score, theDefaultViewOptions);
-    const ScoreLocation &guitar_loc = guitar_caret.getLocation();
-    Caret bass_caret(bass_score, theDefaultViewOptions);
-    const ScoreLocation &bass_loc = bass_caret.getLocation();
+    ScoreLocation guitar_loc(guitar_score);
+    ScoreLocation bass_loc(bass_score);
+    const PlayerChangeIndex guitar_players(guitar_score);
+    const PlayerChangeIndex bass_players(bass_score);
 
-    auto guitar_bar = guitar_bars.begin();
-    const auto end_guitar_bar = guitar_bars.end();
-    auto bass_bar = bass_bars.begin();
-    const auto end_bass_bar = bass_bars.end();
+    size_t guitar_idx = 0;
+    size_t bass_idx = 0;
 
-    while (guitar_bar != end_guitar_bar || bass_bar != end_bass_bar)
+    while (guitar_idx < guitar_bars.size() || bass_idx < bass_bars.size())
     {
         System &dest_system = dest_loc.getSystem();
 
-        const ExpandedBarList::const_iterator current_bar =
-            (guitar_bar != end_guitar_bar) ? guitar_bar : bass_bar;
+        const ExpandedBar *guitar_bar = getBar(guitar_bars, guitar_idx);
+        const ExpandedBar *bass_bar = getBar(bass_bars, bass_idx);
+        const ExpandedBar *current_bar = guitar_bar ? guitar_bar : bass_bar;
 
-        const ExpandedBar *prev_bar = (guitar_bar != guitar_bars.begin())
-                                          ? &*std::prev(current_bar)
-                                          : nullptr;
+        const ExpandedBar *prev_bar = nullptr;
+        if (guitar_idx > 0)
+        {
+            prev_bar = guitar_bar ? &guitar_bars[guitar_idx - 1]
+                                  : &bass_bars[bass_idx - 1];
+        }
 
         // Add a barline if necessary.
         if (dest_loc.getPositionIndex() > 0)
@@ -648,7 +733,7 @@ static void combineScores(Score &dest_score, Score &guitar_score,
                 dest_system.insertBarline(
                     Barline(dest_loc.getPositionIndex(), Barline::RepeatEnd,
                             prev_bar->getRemainingRepeats()));
-                dest_caret.moveHorizontal(1);
+                dest_loc.setPositionIndex(dest_loc.getPositionIndex() + 1);
             }
 
             dest_system.insertBarline(
@@ -667,7 +752,7 @@ static void combineScores(Score &dest_score, Score &guitar_score,
         {
             // Insert notes at the first position after the barline, except when
             // we're at the start of the system.
-            dest_caret.moveHorizontal(1);
+            dest_loc.setPositionIndex(dest_loc.getPositionIndex() + 1);
         }
         else if (barline->getBarType() == Barline::RepeatEnd)
         {
@@ -677,39 +762,38 @@ static void combineScores(Score &dest_score, Score &guitar_score,
         }
 
         int bar_length = 0;
-        if (guitar_bar != end_guitar_bar)
+        if (guitar_bar)
         {
             bar_length = std::max(
                 bar_length, copyContent(dest_loc, num_guitar_staves,
-                                        guitar_caret, *guitar_bar, false));
+                                        guitar_loc, *guitar_bar, false));
         }
-        if (bass_bar != end_bass_bar)
+        if (bass_bar)
         {
             bar_length =
                 std::max(bar_length, copyContent(dest_loc, num_guitar_staves,
-                                                 bass_caret, *bass_bar, true));
+                                                 bass_loc, *bass_bar, true));
         }
 
-        mergePlayerChanges(dest_loc, guitar_loc, bass_loc, guitar_bar,
-                           end_guitar_bar, bass_bar, end_bass_bar,
-                           num_guitar_staves, prev_num_guitar_staves);
+        mergePlayerChanges(dest_loc, guitar_loc, guitar_players, guitar_bar,
+                           bass_loc, bass_players, bass_bar, num_guitar_staves,
+                           prev_num_guitar_staves);
 
         // Advance to the next bar in the source scores.
-        if (guitar_bar != end_guitar_bar)
-            ++guitar_bar;
-        if (bass_bar != end_bass_bar)
-            ++bass_bar;
+        if (guitar_bar)
+            ++guitar_idx;
+        if (bass_bar)
+            ++bass_idx;
 
-        const int next_bar_pos =
-            dest_caret.getLocation().getPositionIndex() + bar_length;
+        const int next_bar_pos = dest_loc.getPositionIndex() + bar_length;
 
         bool need_new_system = next_bar_pos > thePositionLimit;
         need_new_system |= areStavesIncompatible(
-            dest_loc, guitar_caret, bass_caret, guitar_bar, end_guitar_bar,
-            bass_bar, end_bass_bar, num_guitar_staves);
+            dest_loc, guitar_loc, getBar(guitar_bars, guitar_idx), bass_loc,
+            getBar(bass_bars, bass_idx), num_guitar_staves);
 
-        const bool finishing =
-            (guitar_bar == end_guitar_bar && bass_bar == end_bass_bar);
+        const bool finishing = (guitar_idx == guitar_bars.size() &&
+                                bass_idx == bass_bars.size());
 
         if (finishing || need_new_system)
         {
@@ -727,223 +811,280 @@ static void combineScores(Score &dest_score, Score &guitar_score,
             if (!finishing)
             {
                 insertNewSystem(dest_score);
-                dest_caret.moveSystem(1);
+                dest_loc.setSystemIndex(dest_loc.getSystemIndex() + 1);
+                dest_loc.setStaffIndex(0);
+                dest_loc.setPositionIndex(0);
                 prev_num_guitar_staves = num_guitar_staves;
                 num_guitar_staves = 0;
             }
         }
         else
-            dest_caret.moveToPosition(next_bar_pos);
+            dest_loc.setPositionIndex(next_bar_pos);
     }
 }
 
-/// Merge the expanded bars from a multi-bar rest.
-static ExpandedBarList::iterator mergeMultiBarRest(
-    ExpandedBarList &bars, ExpandedBarList::iterator bar, int count)
+/// Returns the index of the next bar that has not been removed.
+static size_t nextBar(const ExpandedBarList &bars, size_t index)
 {
-    bar->setMultiBarRestCount(count);
-
-    // Remove the following bars that were expanded.
-    auto range_begin = bar;
-    auto range_end = bar;
-    std::advance(range_begin, 1);
-    std::advance(range_end, count);
-    return bars.erase(range_begin, range_end);
+    do
+    {
+        ++index;
+    } while (index < bars.size() && bars[index].isRemoved());
+
+    return index;
 }
 
-static void mergeMultiBarRests(ExpandedBarList &guitar_bars,
-                               ExpandedBarList &bass_bars)
+/// Erases any bars that were removed when merging repeats.
+static void eraseRemovedBars(ExpandedBarList &bars)
 {
-    auto guitar_bar = guitar_bars.begin();
-    auto guitar_end_bar = guitar_bars.end();
-    auto bass_bar = bass_bars.begin();
-    auto bass_end_bar = bass_bars.end();
-
-    while (guitar_bar != guitar_end_bar && bass_bar != bass_end_bar)
-    {
-        if (guitar_bar->getMultiBarRestCount() > 0 &&
-            bass_bar->getMultiBarRestCount() > 0)
-        {
-            const int count = std::min(guitar_bar->getMultiBarRestCount(),
-                                       bass_bar->getMultiBarRestCount());
-            guitar_bar = mergeMultiBarRest(guitar_bars, guitar_bar, count);
-            bass_bar = mergeMultiBarRest(bass_bars, bass_bar, count);
-            continue;
-        }
+    bars.erase(std::remove_if(bars.begin(), bars.end(),
+                              [](const ExpandedBar &bar) {
+                                  return bar.isRemoved();
+                              }),
+               bars.end());
+}
 
-        // Otherwise, keep the expanded bars and convert them to a whole rest.
-        if (guitar_bar->getMultiBarRestCount() > 0)
-            guitar_bar->setMultiBarRestCount(1);
-        else if (bass_bar->getMultiBarRestCount() > 0)
-            bass_bar->setMultiBarRestCount(1);
+/// Merge the expanded bars from a multi-bar rest, returning the index of the
+/// next bar after the rest.
+static size_t mergeMultiBarRest(const ExpandedBarList &bars, size_t index,
+                                int count, ExpandedBarList &merged_bars)
+{
+    merged_bars.push_back(bars[index]);
+    merged_bars.back().setMultiBarRestCount(count);
 
-        ++guitar_bar;
-        ++bass_bar;
-    }
+    // Skip over the following bars that were expanded.
+    return std::min(index + count, bars.size());
+}
 
-    while (guitar_bar != guitar_end_bar)
+/// Merges the multi-bar rests from the remainder of a score that is longer than
+/// the other score.
+static void mergeRemainingMultiBarRests(const ExpandedBarList &bars,
+                                        size_t index,
+                                        ExpandedBarList &merged_bars)
+{
+    while (index < bars.size())
     {
-        if (guitar_bar->getMultiBarRestCount() > 0)
+        const ExpandedBar &bar = bars[index];
+        if (bar.getMultiBarRestCount() > 0)
         {
-            guitar_bar = mergeMultiBarRest(guitar_bars, guitar_bar,
-                                           guitar_bar->getMultiBarRestCount());
+            index = mergeMultiBarRest(bars, index, bar.getMultiBarRestCount(),
+                                      merged_bars);
         }
         else
-            ++guitar_bar;
+        {
+            merged_bars.push_back(bar);
+            ++index;
+        }
     }
-    while (bass_bar != bass_end_bar)
+}
+
+static void mergeMultiBarRests(ExpandedBarList &guitar_bars,
+                               ExpandedBarList &bass_bars)
+{
+    ExpandedBarList merged_guitar_bars;
+    ExpandedBarList merged_bass_bars;
+    merged_guitar_bars.reserve(guitar_bars.size());
+    merged_bass_bars.reserve(bass_bars.size());
+
+    size_t guitar_idx = 0;
+    size_t bass_idx = 0;
+
+    while (guitar_idx < guitar_bars.size() && bass_idx < bass_bars.size())
     {
-        if (bass_bar->getMultiBarRestCount() > 0)
+        const ExpandedBar &guitar_bar = guitar_bars[guitar_idx];
+        const ExpandedBar &bass_bar = bass_bars[bass_idx];
+
+        if (guitar_bar.getMultiBarRestCount() > 0 &&
+            bass_bar.getMultiBarRestCount() > 0)
         {
-            bass_bar = mergeMultiBarRest(bass_bars, bass_bar,
-                                         bass_bar->getMultiBarRestCount());
+            const int count = std::min(guitar_bar.getMultiBarRestCount(),
+                                       bass_bar.getMultiBarRestCount());
+            guitar_idx = mergeMultiBarRest(guitar_bars, guitar_idx, count,
+                                           merged_guitar_bars);
+            bass_idx =
+                mergeMultiBarRest(bass_bars, bass_idx, count, merged_bass_bars);
+            continue;
         }
-        else
-            ++bass_bar;
+
+        merged_guitar_bars.push_back(guitar_bar);
+        merged_bass_bars.push_back(bass_bar);
+
+        // Otherwise, keep the expanded bars and convert them to a whole rest.
+        if (guitar_bar.getMultiBarRestCount() > 0)
+            merged_guitar_bars.back().setMultiBarRestCount(1);
+        else if (bass_bar.getMultiBarRestCount() > 0)
+            merged_bass_bars.back().setMultiBarRestCount(1);
+
+        ++guitar_idx;
+        ++bass_idx;
     }
+
+    mergeRemainingMultiBarRests(guitar_bars, guitar_idx, merged_guitar_bars);
+    mergeRemainingMultiBarRests(bass_bars, bass_idx, merged_bass_bars);
+
+    guitar_bars = std::move(merged_guitar_bars);
+    bass_bars = std::move(merged_bass_bars);
 }
 
-static ExpandedBarList::iterator clearRepeatedSection(
-    ExpandedBarList::iterator bar, ExpandedBarList::iterator end_bar)
+static size_t clearRepeatedSection(ExpandedBarList &bars, size_t index)
 {
     bool repeat_end = false;
 
     do
     {
-        repeat_end = bar->isRepeatEnd();
-        bar->clearRepeat();
-        ++bar;
-    } while (!repeat_end && bar != end_bar);
+        ExpandedBar &bar = bars[index];
+        repeat_end = bar.isRepeatEnd();
+        bar.clearRepeat();
+        index = nextBar(bars, index);
+    } while (!repeat_end && index < bars.size());
 
-    return bar;
+    return index;
 }
 
-static ExpandedBarList::iterator collapseRepeatedSection(
-    ExpandedBarList &bars, ExpandedBarList::iterator bar, int num_repeats)
+static size_t collapseRepeatedSection(ExpandedBarList &bars, size_t index,
+                                      int num_repeats)
 {
     // Collapse any non-degenerate repeated sections.
     std::unordered_set<SystemLocation> known_bars;
 
     // Skip the first repeated section.
-    int first_repeat = bar->getRemainingRepeats();
-    while (bar->getRemainingRepeats() == first_repeat)
+    const int first_repeat = bars[index].getRemainingRepeats();
+    while (index < bars.size() &&
+           bars[index].getRemainingRepeats() == first_repeat)
     {
-        known_bars.insert(bar->getLocation());
-        ++bar;
+        known_bars.insert(bars[index].getLocation());
+        index = nextBar(bars, index);
     }
 
     // Remove the following expanded repeats. However, we need to keep any bars
     // that are part of an alternate ending.
     for (int i = first_repeat - 1; i > first_repeat - num_repeats; --i)
     {
-        while (bar != bars.end() && bar->getRemainingRepeats() == i)
+        while (index < bars.size() && bars[index].getRemainingRepeats() == i)
         {
-            if (bar->isAlternateEnding() &&
-                known_bars.find(bar->getLocation()) == known_bars.end())
+            ExpandedBar &bar = bars[index];
+            if (bar.isAlternateEnding() &&
+                known_bars.find(bar.getLocation()) == known_bars.end())
             {
-                known_bars.insert(bar->getLocation());
-                ++bar;
+                known_bars.insert(bar.getLocation());
             }
             else
-                bar = bars.erase(bar);
+                bar.markRemoved();
+
+            index = nextBar(bars, index);
         }
     }
 
-    return bar;
+    return index;
 }
 
 // If one score is longer than another, we can trivially collapse any repeated
 // sections in the longer score.
-static void trivialMergeRepeats(ExpandedBarList &bars,
-                                ExpandedBarList::iterator bar)
+static void trivialMergeRepeats(ExpandedBarList &bars, size_t index)
 {
-    while (bar != bars.end())
+    while (index < bars.size())
     {
-        int remaining_repeats = bar->getRemainingRepeats();
+        int remaining_repeats = bars[index].getRemainingRepeats();
         if (remaining_repeats == 1)
         {
             // Clear degenerate repeated sections.
-            bar = clearRepeatedSection(bar, bars.end());
+            index = clearRepeatedSection(bars, index);
         }
         else if (remaining_repeats > 0)
         {
             // Collapse any non-degenerate repeated sections.
-            bar = collapseRepeatedSection(bars, bar, remaining_repeats);
+            index = collapseRepeatedSection(bars, index, remaining_repeats);
         }
         else
-            ++bar;
+            index = nextBar(bars, index);
     }
 }
 
 static void mergeRepeats(ExpandedBarList &guitar_bars,
                          ExpandedBarList &bass_bars)
 {
-    auto guitar_bar = guitar_bars.begin();
-    auto guitar_end_bar = guitar_bars.end();
-    auto bass_bar = bass_bars.begin();
-    auto bass_end_bar = bass_bars.end();
+    const size_t guitar_end = guitar_bars.size();
+    const size_t bass_end = bass_bars.size();
+    size_t guitar_idx = 0;
+    size_t bass_idx = 0;
 
-    while (guitar_bar != guitar_end_bar && bass_bar != bass_end_bar)
+    while (guitar_idx < guitar_end && bass_idx < bass_end)
     {
-        if (guitar_bar->getStartBar().getBarType() == Barline::RepeatStart &&
-            bass_bar->getStartBar().getBarType() == Barline::RepeatStart)
+        const bool guitar_repeat_start =
+            guitar_bars[guitar_idx].getStartBar().getBarType() ==
+            Barline::RepeatStart;
+        const bool bass_repeat_start =
+            bass_bars[bass_idx].getStartBar().getBarType() ==
+            Barline::RepeatStart;
+
+        if (guitar_repeat_start && bass_repeat_start)
         {
-            auto guitar_section_start = guitar_bar;
-            auto bass_section_start = bass_bar;
-            const int num_repeats = std::min(guitar_bar->getRemainingRepeats(),
-                                             bass_bar->getRemainingRepeats());
-
-            while (!guitar_bar->isRepeatEnd() || !bass_bar->isRepeatEnd())
+            const size_t guitar_section_start = guitar_idx;
+            const size_t bass_section_start = bass_idx;
+            const int num_repeats =
+                std::min(guitar_bars[guitar_idx].getRemainingRepeats(),
+                         bass_bars[bass_idx].getRemainingRepeats());
+
+            while (guitar_idx < guitar_end && bass_idx < bass_end &&
+                   (!guitar_bars[guitar_idx].isRepeatEnd() ||
+                    !bass_bars[bass_idx].isRepeatEnd()))
             {
-                ++guitar_bar;
-                ++bass_bar;
+                guitar_idx = nextBar(guitar_bars, guitar_idx);
+                bass_idx = nextBar(bass_bars, bass_idx);
             }
 
             // The repeated sections are identical in length, and so can be
             // collapsed.
             // TODO - check that alternate endings match.
-            if (guitar_bar->isRepeatEnd() && bass_bar->isRepeatEnd())
+            if (guitar_idx < guitar_end && bass_idx < bass_end)
             {
-                guitar_bar = collapseRepeatedSection(
-                    guitar_bars, guitar_section_start, num_repeats);
-                bass_bar = collapseRepeatedSection(
-                    bass_bars, bass_section_start, num_repeats);
+                collapseRepeatedSection(guitar_bars, guitar_section_start,
+                                        num_repeats);
+                collapseRepeatedSection(bass_bars, bass_section_start,
+                                        num_repeats);
             }
             else
             {
                 // Otherwise, clear the repeat bars from the first expanded
                 // repeat.
-                clearRepeatedSection(guitar_section_start, guitar_end_bar);
-                clearRepeatedSection(bass_section_start, bass_end_bar);
+                clearRepeatedSection(guitar_bars, guitar_section_start);
+                clearRepeatedSection(bass_bars, bass_section_start);
             }
 
-            guitar_bar = guitar_section_start;
-            bass_bar = bass_section_start;
+            guitar_idx = guitar_section_start;
+            bass_idx = bass_section_start;
         }
-        else if (guitar_bar->getStartBar().getBarType() == Barline::RepeatStart)
-            clearRepeatedSection(guitar_bar, guitar_end_bar);
-        else if (bass_bar->getStartBar().getBarType() == Barline::RepeatStart)
-            clearRepeatedSection(bass_bar, bass_end_bar);
+        else if (guitar_repeat_start)
+            clearRepeatedSection(guitar_bars, guitar_idx);
+        else if (bass_repeat_start)
+            clearRepeatedSection(bass_bars, bass_idx);
 
-        ++guitar_bar;
-        ++bass_bar;
+        guitar_idx = nextBar(guitar_bars, guitar_idx);
+        bass_idx = nextBar(bass_bars, bass_idx);
     }
 
     // If the scores have different lengths, deal with the remaining repeated
     // sections.
-    if (guitar_bar != guitar_end_bar)
-        trivialMergeRepeats(guitar_bars, guitar_bar);
-    else if (bass_bar != bass_end_bar)
-        trivialMergeRepeats(bass_bars, bass_bar);
+    if (guitar_idx < guitar_end)
+        trivialMergeRepeats(guitar_bars, guitar_idx);
+    else if (bass_idx < bass_end)
+        trivialMergeRepeats(bass_bars, bass_idx);
+
+    eraseRemovedBars(guitar_bars);
+    eraseRemovedBars(bass_bars);
 }
 
 void ScoreMerger::merge(Score &dest_score, Score &guitar_score,
                         Score &bass_score)
 {
-    ExpandedBarList guitar_bars;
-    ExpandedBarList bass_bars;
-    expandScore(guitar_score, guitar_bars);
-    expandScore(bass_score, bass_bars);
+    Tracing::Span span("ScoreMerger::merge");
+
+    // The two scores are independent, so expand the bass score in the
+    // background.
+    auto bass_task = std::async(std::launch::async, expandScore,
+                                std::cref(bass_score));
+    ExpandedBarList guitar_bars = expandScore(guitar_score);
+    ExpandedBarList bass_bars = bass_task.get();
 
     mergeMultiBarRests(guitar_bars, bass_bars);
     mergeRepeats(guitar_bars, bass_bars);
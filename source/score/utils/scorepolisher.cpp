@@ -17,13 +17,19 @@
 
 #include "scorepolisher.h"
 
+#include <future>
 #include <map>
 #include <optional>
 #include <score/score.h>
-#include <score/voiceutils.h>
 #include <score/utils.h>
+#include <score/utils/voicetiming.h>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/tracing.h>
+
+/// Avoid the overhead of starting threads for small scores.
+static const int theMinSystemsPerThread = 4;
 
 class TimeStamp
 {
@@ -43,7 +49,7 @@ public:
             return myTime < other.myTime;
     }
 
-    void advance(const boost::rational<int> &duration)
+    void advance(int64_t duration)
     {
         myTime += duration;
     }
@@ -54,16 +60,17 @@ public:
     }
 
 private:
-    /// The time from the start of the bar.
-    boost::rational<int> myTime;
+    /// The time from the start of the bar, in ticks.
+    int64_t myTime = 0;
     /// Grace notes occur at the same timestamp as the note that they precede,
     /// but need to appear before the actual note.
     std::optional<int> myGraceNoteNumber;
 };
 
-static int getDefaultNoteSpacing(const boost::rational<int> &duration)
+static int getDefaultNoteSpacing(int64_t duration)
 {
-    return std::max(2 * boost::rational_cast<int>(duration), 1);
+    return std::max(
+        2 * static_cast<int>(duration / VoiceTiming::TICKS_PER_QUARTER), 1);
 }
 
 template <typename T>
@@ -136,6 +143,16 @@ static void computeTimestampPosition(
 
 void ScoreUtils::polishSystem(System &system)
 {
+    // Compute the durations of every position up front. Positions and
+    // irregular groups are only moved around (not added or removed) below,
+    // so the timings remain valid.
+    std::unordered_map<const Voice *, VoiceTiming> timings;
+    for (const Staff &staff : system.getStaves())
+    {
+        for (const Voice &voice : staff.getVoices())
+            timings.emplace(&voice, VoiceTiming(voice));
+    }
+
     // Format each bar separately.
     for (Barline &leftBar : system.getBarlines())
     {
@@ -152,6 +169,7 @@ void ScoreUtils::polishSystem(System &system)
         {
             for (const Voice &voice : staff.getVoices())
             {
+                const VoiceTiming &timing = timings.at(&voice);
                 TimeStamp timestamp;
                 std::optional<int> grace_note;
                 int currentPosition = 0;
@@ -169,8 +187,7 @@ void ScoreUtils::polishSystem(System &system)
 
                     computeTimestampPosition(timestamp, currentPosition,
                                              timestampPositions);
-                    boost::rational<int> duration =
-                        VoiceUtils::getDurationTime(voice, position);
+                    const int64_t duration = timing.getDuration(position);
 
                     currentPosition = timestampPositions[timestamp] +
                                       getDefaultNoteSpacing(duration);
@@ -246,6 +263,42 @@ void ScoreUtils::polishSystem(System &system)
 
 void ScoreUtils::polishScore(Score &score)
 {
-    for (System &system : score.getSystems())
-        polishSystem(system);
+    // hardware_concurrency() may return 0, which is clamped to one thread.
+    polishScore(score, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ScoreUtils::polishScore(Score &score, int num_threads)
+{
+    Tracing::Span span("ScoreUtils::polishScore");
+
+    auto systems = score.getSystems();
+    const int num_systems = static_cast<int>(systems.size());
+    num_threads = std::clamp(num_threads, 1,
+                             std::max(1, num_systems / theMinSystemsPerThread));
+
+    // Polishing a system only moves items around within the system and does
+    // not allocate from the score's memory, so each thread can work on a
+    // separate range of systems.
+    auto polish_range = [&systems](int left, int right) {
+        for (int i = left; i < right; ++i)
+            polishSystem(systems[i]);
+    };
+
+    const int work_size = num_systems / num_threads;
+    std::vector<std::future<void>> tasks;
+    for (int i = 1; i < num_threads; ++i)
+    {
+        const int left = i * work_size;
+        const int right =
+            (i == num_threads - 1) ? num_systems : (i + 1) * work_size;
+
+        tasks.push_back(
+            std::async(std::launch::async, polish_range, left, right));
+    }
+
+    // Handle the first range on the current thread.
+    polish_range(0, work_size);
+
+    for (auto &&task : tasks)
+        task.get();
 }
@@ -23,8 +23,12 @@ class System;
 
 namespace ScoreUtils
 {
-/// Reformats the score.
+/// Reformats the score. The systems are independent, so they are split across
+/// the available hardware threads.
 void polishScore(Score &score);
+/// Reformats the score using up to the given number of threads. The result is
+/// identical to polishing each system in order.
+void polishScore(Score &score, int num_threads);
 /// Reformats a single system.
 void polishSystem(System &system);
 }
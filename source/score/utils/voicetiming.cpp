@@ -0,0 +1,111 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "voicetiming.h"
+
+#include <algorithm>
+#include <cassert>
+#include <score/voice.h>
+
+// 2^6 * 3^2 * 5 * 7 * 11 * 13
+const int64_t VoiceTiming::TICKS_PER_QUARTER = 2882880;
+
+static int64_t getBaseDuration(const Position &pos)
+{
+    if (pos.hasProperty(Position::Acciaccatura))
+        return 0;
+
+    int64_t duration = VoiceTiming::TICKS_PER_QUARTER * 4 /
+                       static_cast<int>(pos.getDurationType());
+
+    // Adjust for dotted notes.
+    if (pos.hasProperty(Position::Dotted))
+        duration += duration / 2;
+    if (pos.hasProperty(Position::DoubleDotted))
+        duration += duration * 3 / 4;
+
+    return duration;
+}
+
+VoiceTiming::VoiceTiming(const Voice &voice)
+{
+    auto positions = voice.getPositions();
+    const size_t n = positions.size();
+    myFirstPosition = n ? &positions[0] : nullptr;
+
+    std::vector<int64_t> durations(n);
+    for (size_t i = 0; i < n; ++i)
+        durations[i] = getBaseDuration(positions[i]);
+
+    // Adjust for irregular groups. As an example, with triplets we have 3
+    // notes played in the time of 2, so each note is 2/3 of its normal
+    // duration.
+    for (const IrregularGrouping &group : voice.getIrregularGroupings())
+    {
+        auto it = std::lower_bound(
+            positions.begin(), positions.end(), group.getPosition(),
+            [](const Position &pos, int position) {
+                return pos.getPosition() < position;
+            });
+        if (it == positions.end() || it->getPosition() != group.getPosition())
+            continue;
+
+        const size_t first = it - positions.begin();
+        const size_t last =
+            std::min(n, first + static_cast<size_t>(group.getLength()));
+        for (size_t i = first; i < last; ++i)
+        {
+            durations[i] = durations[i] * group.getNotesPlayedOver() /
+                           group.getNotesPlayed();
+        }
+    }
+
+    myStartTimes.reserve(n + 1);
+    myStartTimes.push_back(0);
+    for (int64_t duration : durations)
+        myStartTimes.push_back(myStartTimes.back() + duration);
+}
+
+int64_t VoiceTiming::getStartTime(const Position &pos) const
+{
+    return myStartTimes[getIndex(pos)];
+}
+
+int64_t VoiceTiming::getDuration(const Position &pos) const
+{
+    const size_t i = getIndex(pos);
+    return myStartTimes[i + 1] - myStartTimes[i];
+}
+
+int64_t VoiceTiming::getEndTime() const
+{
+    return myStartTimes.back();
+}
+
+double VoiceTiming::toQuarterNotes(int64_t ticks)
+{
+    return static_cast<double>(ticks) / TICKS_PER_QUARTER;
+}
+
+size_t VoiceTiming::getIndex(const Position &pos) const
+{
+    assert(myFirstPosition);
+    const size_t i = &pos - myFirstPosition;
+    assert(i + 1 < myStartTimes.size());
+    return i;
+}
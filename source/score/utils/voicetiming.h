@@ -0,0 +1,65 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SCORE_UTILS_VOICETIMING_H
+#define SCORE_UTILS_VOICETIMING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Position;
+class Voice;
+
+/// Caches the start time and duration of each position in a voice, taking
+/// dots, irregular groupings and grace notes into account. Times are measured
+/// in integer ticks from the start of the voice, so that consumers such as
+/// the score polisher, MIDI export and beaming don't need to repeatedly
+/// search for irregular groupings or use rational arithmetic.
+/// The table must be rebuilt if positions or irregular groupings are added
+/// or removed, or if a position's duration changes.
+class VoiceTiming
+{
+public:
+    /// The number of ticks in a quarter note. This allows for double-dotted
+    /// 64th notes, and is divisible by every tuplet size up to 16 so that
+    /// their durations are exact.
+    static const int64_t TICKS_PER_QUARTER;
+
+    explicit VoiceTiming(const Voice &voice);
+
+    /// Returns the time from the start of the voice until the position.
+    int64_t getStartTime(const Position &pos) const;
+    /// Returns the duration of the position. Grace notes have no duration.
+    int64_t getDuration(const Position &pos) const;
+    /// Returns the time at the end of the last position in the voice.
+    int64_t getEndTime() const;
+
+    /// Converts a number of ticks to a fraction of a quarter note.
+    static double toQuarterNotes(int64_t ticks);
+
+private:
+    size_t getIndex(const Position &pos) const;
+
+    const Position *myFirstPosition;
+    /// The start time of each position, followed by the end time of the
+    /// voice.
+    std::vector<int64_t> myStartTimes;
+};
+
+#endif
@@ -19,7 +19,24 @@
 
 #include "utils.h"
 
-Voice::Voice()
+Voice::Voice() : Voice(allocator_type())
+{
+}
+
+Voice::Voice(const allocator_type &alloc)
+    : myPositions(alloc), myIrregularGroupings(alloc)
+{
+}
+
+Voice::Voice(const Voice &other, const allocator_type &alloc)
+    : myPositions(other.myPositions, alloc),
+      myIrregularGroupings(other.myIrregularGroupings, alloc)
+{
+}
+
+Voice::Voice(Voice &&other, const allocator_type &alloc)
+    : myPositions(std::move(other.myPositions), alloc),
+      myIrregularGroupings(std::move(other.myIrregularGroupings), alloc)
 {
 }
 
@@ -21,18 +21,32 @@
 #include <boost/range/iterator_range_core.hpp>
 #include "fileversion.h"
 #include "irregulargrouping.h"
+#include <memory_resource>
 #include "position.h"
 #include <vector>
 
 class Voice
 {
 public:
+    /// Allocator used for the voice's positions, so that a score can be
+    /// built inside a single memory resource.
+    typedef std::pmr::polymorphic_allocator<std::byte> allocator_type;
+
     Voice();
+    explicit Voice(const allocator_type &alloc);
+    Voice(const Voice &other) = default;
+    Voice(const Voice &other, const allocator_type &alloc);
+    Voice(Voice &&other) noexcept = default;
+    Voice(Voice &&other, const allocator_type &alloc);
+
+    Voice &operator=(const Voice &other) = default;
+    Voice &operator=(Voice &&other) = default;
 
-    typedef std::vector<Position>::iterator PositionIterator;
-    typedef std::vector<Position>::const_iterator PositionConstIterator;
-    typedef std::vector<IrregularGrouping>::iterator IrregularGroupingIterator;
-    typedef std::vector<IrregularGrouping>::const_iterator
+    typedef std::pmr::vector<Position>::iterator PositionIterator;
+    typedef std::pmr::vector<Position>::const_iterator PositionConstIterator;
+    typedef std::pmr::vector<IrregularGrouping>::iterator
+        IrregularGroupingIterator;
+    typedef std::pmr::vector<IrregularGrouping>::const_iterator
     IrregularGroupingConstIterator;
 
     bool operator==(const Voice &other) const;
@@ -65,8 +79,8 @@ public:
     void removeIrregularGrouping(const IrregularGrouping &group);
 
 private:
-    std::vector<Position> myPositions;
-    std::vector<IrregularGrouping> myIrregularGroupings;
+    std::pmr::vector<Position> myPositions;
+    std::pmr::vector<IrregularGrouping> myIrregularGroupings;
 };
 
 template <class Archive>
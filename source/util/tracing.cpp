@@ -0,0 +1,198 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracing.h"
+
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/writer.h>
+#include <utility>
+#include <vector>
+
+std::atomic<bool> Tracing::Detail::theIsEnabled(false);
+
+namespace
+{
+struct Event
+{
+    const char *myName;
+    std::string myDetail;
+    int myThread;
+    std::chrono::steady_clock::time_point myStart;
+    std::chrono::steady_clock::time_point myEnd;
+};
+
+struct TraceData
+{
+    std::mutex myMutex;
+    std::chrono::steady_clock::time_point myStartTime;
+    /// A ring buffer of the recorded spans, which grows up to the capacity.
+    std::vector<Event> myEvents;
+    size_t myCapacity = Tracing::DEFAULT_CAPACITY;
+    /// Once the buffer is full, the index of the oldest span.
+    size_t myOldestEvent = 0;
+    std::vector<std::pair<int, const char *>> myThreadNames;
+};
+}
+
+static TraceData &getTraceData()
+{
+    static TraceData theTraceData;
+    return theTraceData;
+}
+
+/// Returns a small, stable id for the calling thread.
+static int getThreadId()
+{
+    static std::atomic<int> theNextThreadId(1);
+    thread_local const int theThreadId = theNextThreadId++;
+    return theThreadId;
+}
+
+static int64_t toMicroseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+}
+
+void Tracing::enable(size_t capacity)
+{
+    TraceData &data = getTraceData();
+    {
+        std::lock_guard<std::mutex> lock(data.myMutex);
+        data.myEvents.clear();
+        data.myCapacity = std::max<size_t>(capacity, 1);
+        data.myOldestEvent = 0;
+        data.myStartTime = std::chrono::steady_clock::now();
+    }
+
+    Detail::theIsEnabled = true;
+}
+
+void Tracing::disable()
+{
+    Detail::theIsEnabled = false;
+}
+
+void Tracing::setThreadName(const char *name)
+{
+    TraceData &data = getTraceData();
+    std::lock_guard<std::mutex> lock(data.myMutex);
+    data.myThreadNames.emplace_back(getThreadId(), name);
+}
+
+void Tracing::writeChromeTrace(std::ostream &os)
+{
+    TraceData &data = getTraceData();
+    std::lock_guard<std::mutex> lock(data.myMutex);
+
+    rapidjson::OStreamWrapper stream(os);
+    rapidjson::Writer<rapidjson::OStreamWrapper> writer(stream);
+
+    writer.StartObject();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    for (auto &&[thread, name] : data.myThreadNames)
+    {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String("thread_name");
+        writer.Key("ph");
+        writer.String("M");
+        writer.Key("pid");
+        writer.Int(1);
+        writer.Key("tid");
+        writer.Int(thread);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name);
+        writer.EndObject();
+        writer.EndObject();
+    }
+
+    // Use "complete" events, which record both the start time and duration.
+    const size_t num_events = data.myEvents.size();
+    for (size_t i = 0; i < num_events; ++i)
+    {
+        const Event &event =
+            data.myEvents[(data.myOldestEvent + i) % num_events];
+
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(event.myName);
+        writer.Key("ph");
+        writer.String("X");
+        writer.Key("pid");
+        writer.Int(1);
+        writer.Key("tid");
+        writer.Int(event.myThread);
+        writer.Key("ts");
+        writer.Int64(toMicroseconds(event.myStart - data.myStartTime));
+        writer.Key("dur");
+        writer.Int64(toMicroseconds(event.myEnd - event.myStart));
+
+        if (!event.myDetail.empty())
+        {
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("detail");
+            writer.String(event.myDetail.c_str(),
+                          static_cast<rapidjson::SizeType>(
+                              event.myDetail.length()));
+            writer.EndObject();
+        }
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+    stream.Flush();
+}
+
+void Tracing::Span::setDetail(std::string detail)
+{
+    if (myName)
+        myDetail = std::move(detail);
+}
+
+void Tracing::Span::record()
+{
+    const auto end = std::chrono::steady_clock::now();
+
+    TraceData &data = getTraceData();
+    std::lock_guard<std::mutex> lock(data.myMutex);
+
+    // Ignore spans that began before tracing was (re)enabled.
+    if (myStart < data.myStartTime)
+        return;
+
+    Event event{ myName, std::move(myDetail), getThreadId(), myStart, end };
+    if (data.myEvents.size() < data.myCapacity)
+        data.myEvents.push_back(std::move(event));
+    else
+    {
+        data.myEvents[data.myOldestEvent] = std::move(event);
+        data.myOldestEvent = (data.myOldestEvent + 1) % data.myCapacity;
+    }
+}
@@ -0,0 +1,100 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UTIL_TRACING_H
+#define UTIL_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+/// Records timed spans of work (e.g. importing a file or rendering a system),
+/// which can be exported in the Chrome trace event format and then viewed with
+/// chrome://tracing or https://ui.perfetto.dev.
+/// When tracing is disabled, a span only costs a single atomic load.
+namespace Tracing
+{
+namespace Detail
+{
+extern std::atomic<bool> theIsEnabled;
+}
+
+/// The default number of spans that are kept.
+constexpr size_t DEFAULT_CAPACITY = 100000;
+
+/// Starts recording spans, discarding any previously recorded spans.
+/// @param capacity The maximum number of spans to keep. Once this is reached,
+/// the oldest spans are overwritten, so that a long session does not use an
+/// unbounded amount of memory.
+void enable(size_t capacity = DEFAULT_CAPACITY);
+/// Stops recording spans. The recorded spans are kept until the next call to
+/// enable().
+void disable();
+
+inline bool isEnabled()
+{
+    return Detail::theIsEnabled.load(std::memory_order_relaxed);
+}
+
+/// Names the calling thread in the exported trace.
+/// @param name Must be a string literal or otherwise outlive the trace.
+void setThreadName(const char *name);
+
+/// Writes the recorded spans as a Chrome trace (JSON) file.
+void writeChromeTrace(std::ostream &os);
+
+/// Records the time between its construction and destruction, if tracing was
+/// enabled when it was constructed.
+class Span
+{
+public:
+    /// @param name Must be a string literal or otherwise outlive the trace.
+    explicit Span(const char *name)
+        : myName(isEnabled() ? name : nullptr)
+    {
+        if (myName)
+            myStart = std::chrono::steady_clock::now();
+    }
+
+    ~Span()
+    {
+        if (myName)
+            record();
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+    bool isActive() const { return myName != nullptr; }
+
+    /// Attaches extra information to the span, such as a filename. This is
+    /// ignored if the span is not active, but callers should check isActive()
+    /// before doing any expensive work to build the string.
+    void setDetail(std::string detail);
+
+private:
+    void record();
+
+    const char *myName;
+    std::chrono::steady_clock::time_point myStart;
+    std::string myDetail;
+};
+}
+
+#endif
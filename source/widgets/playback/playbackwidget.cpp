@@ -129,6 +129,12 @@ PlaybackWidget::PlaybackWidget(const QAction &play_pause_command,
     connectButtonToAction(ui->rewindToStartButton, &rewind_command);
     connectButtonToAction(ui->stopButton, &stop_command);
 
+    // Only seek once the slider is released, rather than for every
+    // intermediate value.
+    ui->timeSlider->setTracking(false);
+    connect(ui->timeSlider, &QSlider::valueChanged, this,
+            &PlaybackWidget::seekRequested);
+
     connect(ui->zoomComboBox, &QComboBox::currentTextChanged,
             [=](const QString &text) {
                 QLocale locale;
@@ -194,8 +200,16 @@ int PlaybackWidget::getPlaybackSpeed() const
     return ui->speedSpinner->value();
 }
 
+void PlaybackWidget::setPlaybackSpeed(int speed)
+{
+    ui->speedSpinner->setValue(speed);
+}
+
 void PlaybackWidget::setPlaybackMode(bool isPlaying)
 {
+    // The caret is controlled by the MIDI player during playback.
+    ui->timeSlider->setEnabled(!isPlaying);
+
     if (isPlaying)
     {
         ui->playPauseButton->setIcon(
@@ -212,3 +226,27 @@ void PlaybackWidget::updateLocationLabel(const std::string &location)
 {
     ui->locationLabel->setText(QString::fromStdString(location));
 }
+
+static QString formatTime(int64_t msec)
+{
+    const int64_t seconds = msec / 1000;
+    return QStringLiteral("%1:%2")
+        .arg(seconds / 60)
+        .arg(seconds % 60, 2, 10, QLatin1Char('0'));
+}
+
+void PlaybackWidget::updateTime(int64_t current_msec, int64_t total_msec)
+{
+    ui->timeLabel->setText(QStringLiteral("%1 / %2")
+                               .arg(formatTime(current_msec))
+                               .arg(formatTime(total_msec)));
+
+    // Don't move the slider while the user is dragging it.
+    if (ui->timeSlider->isSliderDown())
+        return;
+
+    ui->timeSlider->blockSignals(true);
+    ui->timeSlider->setMaximum(static_cast<int>(total_msec));
+    ui->timeSlider->setValue(static_cast<int>(current_msec));
+    ui->timeSlider->blockSignals(false);
+}
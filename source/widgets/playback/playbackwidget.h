@@ -18,6 +18,7 @@
 #ifndef WIDGETS_PLAYBACKWIDGET_H
 #define WIDGETS_PLAYBACKWIDGET_H
 
+#include <cstdint>
 #include <QWidget>
 
 namespace Ui {
@@ -43,6 +44,8 @@ public:
 
     /// Get the current playback speed.
     int getPlaybackSpeed() const;
+    /// Set the current playback speed.
+    void setPlaybackSpeed(int speed);
 
     /// Toggles the play/pause button.
     void setPlaybackMode(bool isPlaying);
@@ -50,11 +53,18 @@ public:
     /// Updates the text containing the caret's location.
     void updateLocationLabel(const std::string &location);
 
+    /// Updates the playback time for the caret's location, and the total
+    /// length of the score (in milliseconds).
+    void updateTime(int64_t current_msec, int64_t total_msec);
+
 signals:
     void playbackSpeedChanged(int speed);
     void activeVoiceChanged(int voice);
     void activeFilterChanged(int filter);
     void zoomChanged(double zoom);
+    /// Emitted when the user drags the time slider to a new time (in
+    /// milliseconds).
+    void seekRequested(int msec);
 
 private:
     void onSettingChanged(const std::string &setting);
@@ -18,6 +18,7 @@
 #include <catch2/catch.hpp>
 
 #include <actions/addnoteproperty.h>
+#include <actions/removenoteproperty.h>
 #include <score/note.h>
 #include "actionfixture.h"
 
@@ -36,3 +37,32 @@ TEST_CASE_METHOD(ActionFixture, "Actions/AddNoteProperty", "")
     REQUIRE(!myLocation.getNote()->hasProperty(Note::Octave8vb));
     REQUIRE(myLocation.getNote()->hasProperty(Note::Octave8va));
 }
+
+TEST_CASE_METHOD(ActionFixture, "Actions/AddNoteProperty/Merge", "")
+{
+    myLocation.getNote()->setProperty(Note::Octave8va);
+
+    AddNoteProperty action(myLocation, Note::Octave8vb, "Octave 8vb");
+    action.redo();
+
+    // Toggling the property off again is merged into the first command.
+    RemoveNoteProperty remove(myLocation, Note::Octave8vb, "Octave 8vb");
+    remove.redo();
+    REQUIRE(action.id() == remove.id());
+    REQUIRE(action.mergeWith(&remove));
+    REQUIRE(action.text() == remove.text());
+    REQUIRE(!action.isObsolete()); // The 8va property was cleared.
+
+    action.undo();
+    REQUIRE(!myLocation.getNote()->hasProperty(Note::Octave8vb));
+    REQUIRE(myLocation.getNote()->hasProperty(Note::Octave8va));
+
+    action.redo();
+    REQUIRE(!myLocation.getNote()->hasProperty(Note::Octave8vb));
+    REQUIRE(!myLocation.getNote()->hasProperty(Note::Octave8va));
+
+    // Different properties are not merged.
+    AddNoteProperty other(myLocation, Note::Tied, "Tie");
+    other.redo();
+    REQUIRE(!action.mergeWith(&other));
+}
@@ -33,3 +33,27 @@ TEST_CASE_METHOD(ActionFixture, "Actions/EditNoteDuration", "")
     action.undo();
     REQUIRE(myLocation.getPosition()->getDurationType() == Position::HalfNote);
 }
+
+TEST_CASE_METHOD(ActionFixture, "Actions/EditNoteDuration/Merge", "")
+{
+    myLocation.getPosition()->setDurationType(Position::HalfNote);
+
+    EditNoteDuration action(myLocation, Position::QuarterNote, false);
+    action.redo();
+    EditNoteDuration other(myLocation, Position::EighthNote, false);
+    other.redo();
+
+    REQUIRE(action.id() == other.id());
+    REQUIRE(action.mergeWith(&other));
+    REQUIRE(!action.isObsolete());
+
+    action.undo();
+    REQUIRE(myLocation.getPosition()->getDurationType() == Position::HalfNote);
+    action.redo();
+    REQUIRE(myLocation.getPosition()->getDurationType() == Position::EighthNote);
+
+    EditNoteDuration restore(myLocation, Position::HalfNote, false);
+    restore.redo();
+    REQUIRE(action.mergeWith(&restore));
+    REQUIRE(action.isObsolete());
+}
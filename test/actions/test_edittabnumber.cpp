@@ -52,3 +52,38 @@ TEST_CASE_METHOD(ActionFixture, "Actions/EditTabNumber/HighTappedHarmonic", "")
     REQUIRE(myLocation.getNote()->getFretNumber() == 5);
     REQUIRE(myLocation.getNote()->getTappedHarmonicFret() == 29);
 }
+
+TEST_CASE_METHOD(ActionFixture, "Actions/EditTabNumber/Merge", "")
+{
+    myLocation.getNote()->setFretNumber(5);
+
+    EditTabNumber action(myLocation, 1);
+    action.redo();
+
+    // Typing a second digit is merged into the first edit.
+    EditTabNumber other(myLocation, 2);
+    other.redo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 12);
+
+    REQUIRE(action.id() == other.id());
+    REQUIRE(action.mergeWith(&other));
+    REQUIRE(!action.isObsolete());
+
+    action.undo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 5);
+    action.redo();
+    REQUIRE(myLocation.getNote()->getFretNumber() == 12);
+
+    // Edits of a different note are not merged.
+    ScoreLocation location(myLocation);
+    location.setString(5);
+    EditTabNumber otherNote(location, 3);
+    otherNote.redo();
+    REQUIRE(!action.mergeWith(&otherNote));
+
+    // Restoring the original number makes the command obsolete.
+    EditTabNumber restore(myLocation, 5);
+    restore.redo();
+    REQUIRE(action.mergeWith(&restore));
+    REQUIRE(action.isObsolete());
+}
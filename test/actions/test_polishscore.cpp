@@ -0,0 +1,57 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <actions/polishscore.h>
+#include <score/score.h>
+
+TEST_CASE("Actions/PolishScore", "")
+{
+    Score score;
+
+    // The first system is already formatted.
+    System system;
+    Staff staff(6);
+    staff.getVoices()[0].insertPosition(Position(0, Position::QuarterNote));
+    staff.getVoices()[0].insertPosition(Position(2, Position::QuarterNote));
+    system.insertStaff(staff);
+    system.getBarlines().back().setPosition(4);
+    score.insertSystem(system);
+
+    // The second system has too much space between the notes.
+    staff.getVoices()[0].getPositions()[1].setPosition(10);
+    system.getStaves()[0] = staff;
+    system.getBarlines().back().setPosition(12);
+    score.insertSystem(system);
+
+    const std::vector<System> original_systems(score.getSystems().begin(),
+                                               score.getSystems().end());
+    PolishScore action(score);
+
+    action.redo();
+    REQUIRE(score.getSystems()[0] == original_systems[0]);
+    REQUIRE(score.getSystems()[1]
+                .getStaves()[0]
+                .getVoices()[0]
+                .getPositions()[1]
+                .getPosition() == 2);
+
+    action.undo();
+    REQUIRE(score.getSystems()[0] == original_systems[0]);
+    REQUIRE(score.getSystems()[1] == original_systems[1]);
+}
@@ -0,0 +1,252 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <actions/undomanager.h>
+#include <QUndoCommand>
+#include <vector>
+
+namespace
+{
+/// Records the order in which the command is performed or undone.
+class RecordingCommand : public QUndoCommand
+{
+public:
+    RecordingCommand(std::vector<int> &log, int value)
+        : QUndoCommand(QStringLiteral("Test")), myLog(log), myValue(value)
+    {
+    }
+
+    void redo() override
+    {
+        myLog.push_back(myValue);
+    }
+
+    void undo() override
+    {
+        myLog.push_back(-myValue);
+    }
+
+private:
+    std::vector<int> &myLog;
+    const int myValue;
+};
+
+/// Adds a value, and merges with other commands that add a value.
+class AddCommand : public QUndoCommand
+{
+public:
+    AddCommand(int &total, int value)
+        : QUndoCommand(QStringLiteral("Add")), myTotal(total), myValue(value)
+    {
+    }
+
+    void redo() override
+    {
+        myTotal += myValue;
+    }
+
+    void undo() override
+    {
+        myTotal -= myValue;
+    }
+
+    int id() const override
+    {
+        return 1;
+    }
+
+    bool mergeWith(const QUndoCommand *other) override
+    {
+        myValue += static_cast<const AddCommand *>(other)->myValue;
+        setObsolete(myValue == 0);
+        return true;
+    }
+
+private:
+    int &myTotal;
+    int myValue;
+};
+
+struct RedrawCounter
+{
+    explicit RedrawCounter(UndoManager &manager)
+    {
+        QObject::connect(&manager, &UndoManager::redrawNeeded,
+                         [this](int system) { mySystems.push_back(system); });
+        QObject::connect(&manager, &UndoManager::fullRedrawNeeded,
+                         [this]() { ++myFullRedraws; });
+    }
+
+    void clear()
+    {
+        mySystems.clear();
+        myFullRedraws = 0;
+    }
+
+    std::vector<int> mySystems;
+    int myFullRedraws = 0;
+};
+}
+
+TEST_CASE("Actions/UndoManager/Push", "")
+{
+    UndoManager manager;
+    manager.addNewUndoStack();
+    manager.setActiveStackIndex(0);
+    RedrawCounter counter(manager);
+    std::vector<int> log;
+
+    manager.push(new RecordingCommand(log, 1), 3);
+    REQUIRE(log == std::vector<int>{ 1 });
+    REQUIRE(counter.mySystems == std::vector<int>{ 3 });
+    REQUIRE(manager.activeStack()->count() == 1);
+
+    manager.undo();
+    REQUIRE(log == std::vector<int>({ 1, -1 }));
+    REQUIRE(counter.mySystems == std::vector<int>({ 3, 3 }));
+
+    counter.clear();
+    manager.push(new RecordingCommand(log, 2),
+                 UndoManager::AFFECTS_ALL_SYSTEMS);
+    REQUIRE(counter.mySystems.empty());
+    REQUIRE(counter.myFullRedraws == 1);
+}
+
+TEST_CASE("Actions/UndoManager/Macro", "")
+{
+    UndoManager manager;
+    manager.addNewUndoStack();
+    manager.setActiveStackIndex(0);
+    RedrawCounter counter(manager);
+    std::vector<int> log;
+
+    manager.beginMacro(QStringLiteral("Macro"));
+    manager.push(new RecordingCommand(log, 1), 1);
+    manager.push(new RecordingCommand(log, 2), 1);
+
+    // Nested macros are merged into the outer macro.
+    manager.beginMacro(QStringLiteral("Nested"));
+    manager.push(new RecordingCommand(log, 3), 2);
+    manager.endMacro();
+
+    // Commands are performed immediately, but redraws are deferred.
+    REQUIRE(log == std::vector<int>({ 1, 2, 3 }));
+    REQUIRE(counter.mySystems.empty());
+
+    manager.endMacro();
+    REQUIRE(log == std::vector<int>({ 1, 2, 3 }));
+    REQUIRE(counter.mySystems == std::vector<int>({ 1, 2 }));
+    REQUIRE(manager.activeStack()->count() == 1);
+
+    counter.clear();
+    log.clear();
+    manager.undo();
+    REQUIRE(log == std::vector<int>({ -3, -2, -1 }));
+    REQUIRE(counter.mySystems == std::vector<int>({ 1, 2 }));
+
+    counter.clear();
+    log.clear();
+    manager.redo();
+    REQUIRE(log == std::vector<int>({ 1, 2, 3 }));
+    REQUIRE(counter.mySystems == std::vector<int>({ 1, 2 }));
+
+    // A full redraw replaces any individual system redraws.
+    counter.clear();
+    manager.beginMacro(QStringLiteral("Macro"));
+    manager.push(new RecordingCommand(log, 4), 1);
+    manager.push(new RecordingCommand(log, 5),
+                 UndoManager::AFFECTS_ALL_SYSTEMS);
+    manager.endMacro();
+    REQUIRE(counter.mySystems.empty());
+    REQUIRE(counter.myFullRedraws == 1);
+
+    // An empty macro does not create an undo entry.
+    manager.beginMacro(QStringLiteral("Empty"));
+    manager.endMacro();
+    REQUIRE(manager.activeStack()->count() == 2);
+}
+
+TEST_CASE("Actions/UndoManager/Merge", "")
+{
+    UndoManager manager;
+    manager.addNewUndoStack();
+    manager.setActiveStackIndex(0);
+    RedrawCounter counter(manager);
+    int total = 0;
+
+    manager.push(new AddCommand(total, 1), 0);
+    manager.push(new AddCommand(total, 2), 0);
+    REQUIRE(total == 3);
+    REQUIRE(manager.activeStack()->count() == 1);
+
+    // Commands affecting a different system are not merged.
+    manager.push(new AddCommand(total, 4), 1);
+    REQUIRE(manager.activeStack()->count() == 2);
+
+    // A macro containing a single command can be merged, and commands
+    // within a macro are merged with each other.
+    manager.beginMacro(QStringLiteral("Macro"));
+    manager.push(new AddCommand(total, 8), 1);
+    manager.push(new AddCommand(total, 16), 1);
+    manager.endMacro();
+    REQUIRE(total == 31);
+    REQUIRE(manager.activeStack()->count() == 2);
+
+    counter.clear();
+    manager.undo();
+    REQUIRE(total == 3);
+    REQUIRE(counter.mySystems == std::vector<int>{ 1 });
+
+    manager.undo();
+    REQUIRE(total == 0);
+
+    // A merged command that has no effect is removed from the stack.
+    manager.redo();
+    manager.redo();
+    manager.push(new AddCommand(total, -28), 1);
+    REQUIRE(total == 3);
+    REQUIRE(manager.activeStack()->count() == 1);
+}
+
+TEST_CASE("Actions/UndoManager/Revision", "")
+{
+    UndoManager manager;
+    manager.addNewUndoStack();
+    manager.addNewUndoStack();
+    manager.setActiveStackIndex(1);
+    int total = 0;
+
+    REQUIRE(manager.getRevision(1) == 0);
+    manager.push(new AddCommand(total, 1), 0);
+    const uint64_t revision = manager.getRevision(1);
+    REQUIRE(revision > 0);
+
+    // Merging with the previous command leaves the stack's index unchanged,
+    // but is still a modification.
+    const int index = manager.activeStack()->index();
+    manager.push(new AddCommand(total, 2), 0);
+    REQUIRE(manager.activeStack()->index() == index);
+    REQUIRE(manager.getRevision(1) > revision);
+
+    // Undoing also changes the revision, and other stacks are unaffected.
+    const uint64_t merged_revision = manager.getRevision(1);
+    manager.undo();
+    REQUIRE(manager.getRevision(1) > merged_revision);
+    REQUIRE(manager.getRevision(0) == 0);
+}
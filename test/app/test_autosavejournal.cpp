@@ -0,0 +1,186 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <app/autosavejournal.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <ctime>
+#include <score/score.h>
+
+namespace fs = boost::filesystem;
+
+static void addSystem(Score &score, int numStaves)
+{
+    System system;
+    for (int i = 0; i < numStaves; ++i)
+        system.insertStaff(Staff());
+    score.insertSystem(system);
+}
+
+TEST_CASE("App/AutosaveJournal/Replay", "")
+{
+    const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+    const fs::path base_file = dir / "test.pt2";
+
+    Score saved;
+    addSystem(saved, 1);
+    addSystem(saved, 1);
+
+    Score score;
+    addSystem(score, 1);
+    addSystem(score, 1);
+
+    {
+        AutosaveJournal journal(dir, base_file);
+        REQUIRE(!journal.hasChanges());
+        REQUIRE(AutosaveJournal::readBaseFile(journal.getPath()) == base_file);
+
+        // Our own journal should not be recovered.
+        REQUIRE(AutosaveJournal::findOrphanedJournals(dir).empty());
+
+        // Modify a single system.
+        score.getSystems()[1].insertBarline(Barline(5, Barline::DoubleBar));
+        journal.markSystemModified(1);
+        REQUIRE(journal.hasChanges());
+        journal.write(score);
+        REQUIRE(!journal.hasChanges());
+
+        // Insert a system and change some score-level data.
+        addSystem(score, 2);
+        score.insertPlayer(Player());
+        score.setLineSpacing(12);
+        journal.markAllModified();
+        journal.write(score);
+
+        // Remove a system.
+        score.removeSystem(0);
+        journal.markAllModified();
+        journal.write(score);
+        journal.flush();
+
+        Score recovered;
+        addSystem(recovered, 1);
+        addSystem(recovered, 1);
+        AutosaveJournal::replay(journal.getPath(), recovered);
+        REQUIRE(recovered == score);
+
+        // A partially written entry should be ignored.
+        {
+            fs::ofstream file(journal.getPath(),
+                              std::ios::out | std::ios::app);
+            file << "1000\n{\"version\": ";
+        }
+
+        Score partial;
+        addSystem(partial, 1);
+        addSystem(partial, 1);
+        AutosaveJournal::replay(journal.getPath(), partial);
+        REQUIRE(partial == score);
+
+        // After saving, the journal should be empty again.
+        journal.reset(base_file);
+        Score unchanged;
+        addSystem(unchanged, 1);
+        addSystem(unchanged, 1);
+        AutosaveJournal::replay(journal.getPath(), unchanged);
+        REQUIRE(unchanged == saved);
+    }
+
+    // The journal is removed when the document is closed normally.
+    REQUIRE(fs::is_empty(dir));
+    fs::remove_all(dir);
+}
+
+TEST_CASE("App/AutosaveJournal/Untitled", "")
+{
+    const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+
+    Score score;
+    addSystem(score, 1);
+
+    {
+        // For a new document, the first entry should contain the whole score.
+        AutosaveJournal journal(dir, std::nullopt);
+        REQUIRE(journal.hasChanges());
+        REQUIRE(!AutosaveJournal::readBaseFile(journal.getPath()));
+
+        journal.write(score);
+        journal.flush();
+
+        Score recovered;
+        AutosaveJournal::replay(journal.getPath(), recovered);
+        REQUIRE(recovered == score);
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("App/AutosaveJournal/OldLock", "")
+{
+    const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+
+    {
+        AutosaveJournal journal(dir, std::nullopt);
+
+        // A journal whose lock is still held should not be recovered, no
+        // matter how long ago the lock was taken.
+        const fs::path lock_path = journal.getPath().string() + ".lock";
+        REQUIRE(fs::exists(lock_path));
+        fs::last_write_time(lock_path, std::time(nullptr) - 3600);
+
+        REQUIRE(AutosaveJournal::findOrphanedJournals(dir).empty());
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("App/AutosaveJournal/WriteError", "")
+{
+    const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+
+    Score score;
+    addSystem(score, 1);
+    addSystem(score, 1);
+
+    {
+        AutosaveJournal journal(dir, std::nullopt);
+
+        // Prevent the journal file from being opened.
+        const fs::path backup = dir / "backup";
+        fs::rename(journal.getPath(), backup);
+        fs::create_directory(journal.getPath());
+
+        journal.markSystemModified(1);
+        journal.write(score);
+        REQUIRE_THROWS(journal.flush());
+
+        // The next entry should include the whole score.
+        REQUIRE(journal.hasChanges());
+        fs::remove(journal.getPath());
+        fs::rename(backup, journal.getPath());
+        journal.write(score);
+        journal.flush();
+
+        Score recovered;
+        AutosaveJournal::replay(journal.getPath(), recovered);
+        REQUIRE(recovered.getSystems().size() == 2);
+    }
+
+    fs::remove_all(dir);
+}
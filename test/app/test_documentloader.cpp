@@ -0,0 +1,114 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <app/appinfo.h>
+#include <app/documentloader.h>
+#include <app/documentmanager.h>
+#include <app/settingsmanager.h>
+#include <formats/fileformatmanager.h>
+#include <map>
+#include <thread>
+
+TEST_CASE("App/DocumentLoader/Concurrent", "")
+{
+    SettingsManager settings;
+    FileFormatManager manager(settings);
+
+    const std::vector<std::string> files = {
+        "data/barlines.ptb", "data/notes.ptb",   "data/tempo_markers.ptb",
+        "data/barlines.gp5", "data/notes.gp5",   "data/irregular.gp5",
+        "data/text.gpx",     "data/test_editstaff.pt2"
+    };
+
+    // Import each file several times, so that the same importer is used
+    // concurrently on the same file as well as on different files.
+    std::vector<DocumentLoader::Request> requests;
+    for (int i = 0; i < 3; ++i)
+    {
+        for (const std::string &file : files)
+        {
+            const DocumentLoader::PathType path =
+                AppInfo::getAbsolutePath(file.c_str());
+            requests.emplace_back(
+                path, *manager.findFormat(path.extension().string().substr(1)));
+        }
+    }
+
+    std::vector<DocumentLoader::Result> results;
+    {
+        DocumentLoader loader(manager, requests, 4);
+        REQUIRE(loader.getNumRequests() == requests.size());
+
+        while (!loader.isFinished())
+        {
+            for (auto &result : loader.takeFinished())
+                results.push_back(std::move(result));
+
+            std::this_thread::yield();
+        }
+
+        for (auto &result : loader.takeFinished())
+            results.push_back(std::move(result));
+
+        REQUIRE(loader.getNumCompleted() == requests.size());
+    }
+
+    REQUIRE(results.size() == requests.size());
+
+    // Every result should match a serial import of the same file.
+    std::map<DocumentLoader::PathType, int> counts;
+    for (const DocumentLoader::Result &result : results)
+    {
+        INFO(result.myPath.string());
+        REQUIRE(result.myError.empty());
+        REQUIRE(result.myDocument);
+        REQUIRE(result.myDocument->getFilename() == result.myPath);
+
+        Score expected;
+        manager.importFile(
+            expected, result.myPath,
+            *manager.findFormat(result.myPath.extension().string().substr(1)));
+        REQUIRE(result.myDocument->getScore() == expected);
+
+        ++counts[result.myPath];
+    }
+
+    REQUIRE(counts.size() == files.size());
+    for (auto &count : counts)
+        REQUIRE(count.second == 3);
+}
+
+TEST_CASE("App/DocumentLoader/Errors", "")
+{
+    SettingsManager settings;
+    FileFormatManager manager(settings);
+
+    std::vector<DocumentLoader::Request> requests;
+    requests.emplace_back(AppInfo::getAbsolutePath("data/missing.gp5"),
+                          *manager.findFormat("gp5"));
+
+    DocumentLoader loader(manager, requests);
+    while (!loader.isFinished())
+        std::this_thread::yield();
+
+    std::vector<DocumentLoader::Result> results = loader.takeFinished();
+    REQUIRE(results.size() == 1);
+    REQUIRE(!results[0].myDocument);
+    REQUIRE(!results[0].myError.empty());
+}
@@ -18,6 +18,7 @@
 #include <catch2/catch.hpp>
 
 #include <app/documentmanager.h>
+#include <score/score.h>
 
 TEST_CASE("App/DocumentManager", "")
 {
@@ -49,3 +50,34 @@ TEST_CASE("App/Document", "")
     REQUIRE(!document.hasFilename());
 }
 
+
+TEST_CASE("App/Document/CompressScore", "")
+{
+    Document document;
+    Score &score = document.getScore();
+    score.insertSystem(System());
+    score.insertSystem(System());
+    score.insertPlayer(Player());
+    ScoreUtils::addStandardFilters(score);
+
+    std::unique_ptr<Score> expected = score.clone();
+
+    document.compressScore();
+    REQUIRE(document.isScoreCompressed());
+
+    // The const accessor can't restore the score.
+    const Document &constDocument = document;
+    REQUIRE_THROWS_AS(constDocument.getScore(), std::logic_error);
+
+    document.ensureDecompressed();
+    REQUIRE(!document.isScoreCompressed());
+    REQUIRE(constDocument.getScore() == *expected);
+
+    // Modifying the score also restores it first.
+    document.compressScore();
+    document.getScore();
+    REQUIRE(!document.isScoreCompressed());
+
+    // The same score object is used, since it may be referenced elsewhere.
+    REQUIRE(&document.getScore() == &score);
+}
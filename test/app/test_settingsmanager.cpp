@@ -39,3 +39,40 @@ TEST_CASE("App/SettingsManager", "")
 
     REQUIRE(count == 1);
 }
+
+TEST_CASE("App/SettingsManager/Snapshot", "")
+{
+    SettingsManager manager;
+    {
+        auto settings = manager.getWriteHandle();
+        settings->set("foo", 1);
+    }
+
+    auto snapshot = manager.getReadHandle();
+    {
+        auto settings = manager.getWriteHandle();
+        settings->set("foo", 2);
+
+        // Changes aren't visible until the write handle is released.
+        REQUIRE(manager.getReadHandle()->get<int>("foo") == 1);
+    }
+
+    REQUIRE(snapshot->get<int>("foo") == 1);
+    REQUIRE(manager.getReadHandle()->get<int>("foo") == 2);
+}
+
+TEST_CASE("App/SettingsManager/CachedSetting", "")
+{
+    const Setting<bool> setting("foo/bar", true);
+    SettingsManager manager;
+
+    CachedSetting<bool> value(manager, setting);
+    REQUIRE(value.get() == true);
+
+    {
+        auto settings = manager.getWriteHandle();
+        settings->set(setting, false);
+    }
+
+    REQUIRE(value.get() == false);
+}
@@ -0,0 +1,63 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <audio/midioutputdevice.h>
+#include <audio/midirecordingsink.h>
+
+TEST_CASE("Audio/MidiOutputDevice/Messages", "")
+{
+    MidiRecordingSink sink(16);
+    MidiOutputDevice device(sink);
+
+    REQUIRE(device.playNote(2, 64, 90));
+    REQUIRE(device.setPatch(3, 30));
+    device.sendMessage({ 0x82, 64, 0 });
+
+    REQUIRE(sink.getMessageCount() == 3);
+
+    const auto &note_on = sink.getMessage(0);
+    REQUIRE(note_on.myLength == 3);
+    REQUIRE(note_on.myData[0] == MidiOutputDevice::NoteOn + 2);
+    REQUIRE(note_on.myData[1] == 64);
+    REQUIRE(note_on.myData[2] == 90);
+
+    // Program changes only have a single data byte.
+    const auto &program_change = sink.getMessage(1);
+    REQUIRE(program_change.myLength == 2);
+    REQUIRE(program_change.myData[0] == MidiOutputDevice::ProgramChange + 3);
+    REQUIRE(program_change.myData[1] == 30);
+
+    const auto &note_off = sink.getMessage(2);
+    REQUIRE(note_off.myLength == 3);
+    REQUIRE(note_off.myData[0] == 0x82);
+}
+
+TEST_CASE("Audio/MidiOutputDevice/StopAllNotes", "")
+{
+    MidiRecordingSink sink(64);
+    MidiOutputDevice device(sink);
+
+    device.stopAllNotes();
+
+    // Sustain is released and all notes are stopped on each channel.
+    REQUIRE(sink.getMessageCount() == 2 * MidiOutputDevice::NUM_CHANNELS);
+    const auto &last = sink.getMessage(sink.getMessageCount() - 1);
+    REQUIRE(last.myData[0] == MidiOutputDevice::ControlChange + 15);
+    REQUIRE(last.myData[1] == MidiOutputDevice::AllNotesOff);
+}
@@ -0,0 +1,117 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <app/settingsmanager.h>
+#include <audio/midioutputdevice.h>
+#include <audio/midioutputservice.h>
+#include <audio/midiplayer.h>
+#include <audio/midirecordingsink.h>
+#include <audio/settings.h>
+#include <chrono>
+#include <score/score.h>
+#include <score/scorelocation.h>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Audio/MidiPlayer/Record", "")
+{
+    Score score;
+    score.insertPlayer(Player());
+    score.insertInstrument(Instrument());
+
+    // A bar with two quarter notes.
+    {
+        System system;
+        Staff staff(6);
+        Voice &voice = staff.getVoices()[0];
+
+        Position first(0, Position::QuarterNote);
+        first.insertNote(Note(2, 0));
+        voice.insertPosition(first);
+
+        Position second(1, Position::QuarterNote);
+        second.insertNote(Note(1, 3));
+        voice.insertPosition(second);
+
+        system.insertStaff(staff);
+
+        PlayerChange change;
+        change.insertActivePlayer(0, ActivePlayer(0, 0));
+        system.insertPlayerChange(change);
+
+        score.insertSystem(system);
+    }
+
+    SettingsManager settings_manager;
+    {
+        auto settings = settings_manager.getWriteHandle();
+        settings->set(Settings::CountInEnabled, false);
+        settings->set(Settings::MetronomeEnabled, false);
+    }
+
+    MidiRecordingSink sink(256);
+    MidiOutputService output_service(settings_manager, sink);
+
+    // Play at 10x speed, so that each beat is 50ms.
+    {
+        MidiPlayer player(settings_manager, output_service,
+                          ScoreLocation(score, 0, 0), 1000);
+        player.start();
+        player.wait();
+    }
+
+    std::vector<const MidiRecordingSink::Message *> notes;
+    for (size_t i = 0; i < sink.getMessageCount(); ++i)
+    {
+        const MidiRecordingSink::Message &msg = sink.getMessage(i);
+        const uint8_t status = msg.myData[0] & 0xf0;
+        if (status == MidiOutputDevice::NoteOn ||
+            status == MidiOutputDevice::NoteOff)
+        {
+            notes.push_back(&msg);
+        }
+    }
+
+    // Each note is played on the first channel and stopped before the next
+    // one starts.
+    const Tuning &tuning = score.getPlayers()[0].getTuning();
+    const uint8_t pitches[] = { tuning.getNote(2, false),
+                                static_cast<uint8_t>(tuning.getNote(1, false) +
+                                                     3) };
+
+    REQUIRE(notes.size() == 4);
+    for (int i = 0; i < 2; ++i)
+    {
+        const MidiRecordingSink::Message &note_on = *notes[2 * i];
+        REQUIRE(note_on.myData[0] == MidiOutputDevice::NoteOn);
+        REQUIRE(note_on.myData[1] == pitches[i]);
+        REQUIRE(note_on.myData[2] > 0);
+
+        // Note offs may also be sent as a note on with zero velocity.
+        const MidiRecordingSink::Message &note_off = *notes[2 * i + 1];
+        REQUIRE(note_off.myData[1] == pitches[i]);
+        REQUIRE((note_off.myData[0] == MidiOutputDevice::NoteOff ||
+                 note_off.myData[2] == 0));
+    }
+
+    // The second note is played one beat after the first.
+    const auto delay = notes[2]->myTimestamp - notes[0]->myTimestamp;
+    REQUIRE(delay >= 40ms);
+    REQUIRE(delay < 500ms);
+}
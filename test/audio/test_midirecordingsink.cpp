@@ -0,0 +1,67 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <audio/midirecordingsink.h>
+
+TEST_CASE("Audio/MidiRecordingSink/Record", "")
+{
+    MidiRecordingSink sink(4);
+    REQUIRE(sink.getMessageCount() == 0);
+
+    const uint8_t note_on[] = { 0x90, 60, 100 };
+    const uint8_t program_change[] = { 0xC0, 25 };
+    sink.sendMessage(note_on, 3);
+    sink.sendMessage(program_change, 2);
+
+    REQUIRE(sink.getMessageCount() == 2);
+    REQUIRE(sink.getTotalMessageCount() == 2);
+
+    const auto &first = sink.getMessage(0);
+    REQUIRE(first.myLength == 3);
+    REQUIRE(first.myData[0] == 0x90);
+    REQUIRE(first.myData[1] == 60);
+    REQUIRE(first.myData[2] == 100);
+
+    const auto &second = sink.getMessage(1);
+    REQUIRE(second.myLength == 2);
+    REQUIRE(second.myData[1] == 25);
+    REQUIRE(second.myTimestamp >= first.myTimestamp);
+
+    sink.clear();
+    REQUIRE(sink.getMessageCount() == 0);
+    REQUIRE(sink.getTotalMessageCount() == 0);
+}
+
+TEST_CASE("Audio/MidiRecordingSink/Overflow", "")
+{
+    MidiRecordingSink sink(3);
+
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        const uint8_t message[] = { 0x80, i, 0 };
+        sink.sendMessage(message, 3);
+    }
+
+    // Only the most recent messages are kept.
+    REQUIRE(sink.getTotalMessageCount() == 5);
+    REQUIRE(sink.getMessageCount() == 3);
+    REQUIRE(sink.getMessage(0).myData[1] == 2);
+    REQUIRE(sink.getMessage(1).myData[1] == 3);
+    REQUIRE(sink.getMessage(2).myData[1] == 4);
+}
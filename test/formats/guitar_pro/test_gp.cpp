@@ -19,7 +19,9 @@
 
 #include <app/appinfo.h>
 #include <formats/guitar_pro/guitarproimporter.h>
+#include <formats/guitar_pro/inputstream.h>
 #include <score/score.h>
+#include <sstream>
 
 static void loadTest(GuitarProImporter &importer, const char *filename,
                      Score &score)
@@ -289,3 +291,29 @@ TEST_CASE("Formats/GuitarPro/IrregularGroups", "")
     REQUIRE(groups[2].getNotesPlayed() == 6);
     REQUIRE(groups[2].getNotesPlayedOver() == 4);
 }
+
+TEST_CASE("Formats/GuitarPro/InputStream", "")
+{
+    // A version string padded out to 31 bytes, followed by a few values.
+    std::string data;
+    const std::string version = "FICHIER GUITAR PRO v5.00";
+    data += static_cast<char>(version.size());
+    data += version;
+    data.resize(31, '\0');
+    data += std::string("\x04\x03\x02\x01", 4);
+    data += std::string("\x04\x00\x00\x00\x03" "abc", 8);
+    data += std::string("\x02\x00", 2);
+
+    std::istringstream input(data);
+    Gp::InputStream stream(input);
+    REQUIRE(stream.getVersion() == Gp::Version5_0);
+
+    REQUIRE(stream.read<uint32_t>() == 0x01020304);
+    REQUIRE(stream.readStringView() == "abc");
+    REQUIRE(stream.read<uint8_t>() == 2);
+
+    // Reading past the end of the file should be reported as an error.
+    REQUIRE_THROWS_AS(stream.read<uint16_t>(), FileFormatException);
+    stream.skip(2);
+    REQUIRE_THROWS_AS(stream.read<uint8_t>(), FileFormatException);
+}
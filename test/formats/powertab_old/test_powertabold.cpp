@@ -379,3 +379,27 @@ TEST_CASE("Formats/PowerTabOldImport/MergeMultiBarRests", "")
 
     REQUIRE(score == expected_score);
 }
+
+TEST_CASE("Formats/PowerTabOldImport/MergedScores", "")
+{
+    // The expected scores were imported with the original version of the
+    // score merger, and then re-saved in the current file format.
+    for (const std::string name :
+         { "alternate_endings", "barlines", "bends", "chordtext", "directions",
+           "floating_text", "guitar_ins", "guitars", "notes", "positions",
+           "song_header", "staves", "tempo_markers" })
+    {
+        INFO(name);
+
+        Score score;
+        Score expected_score;
+
+        PowerTabOldImporter old_importer;
+        PowerTabImporter importer;
+        loadTest(old_importer, ("data/" + name + ".ptb").c_str(), score);
+        loadTest(importer, ("data/" + name + "_merged.pt2").c_str(),
+                 expected_score);
+
+        REQUIRE(score == expected_score);
+    }
+}
@@ -17,7 +17,12 @@
 
 #include <catch2/catch.hpp>
 
+#include <app/settingsmanager.h>
+#include <boost/filesystem/operations.hpp>
 #include <formats/fileformat.h>
+#include <formats/fileformatmanager.h>
+#include <formats/settings.h>
+#include <score/score.h>
 
 TEST_CASE("Formats/FileFormat/FileFilterSingle", "Single Extension")
 {
@@ -32,3 +37,65 @@ TEST_CASE("Formats/FileFormat/FileFilterMulti", "Multiple Extensions")
 
     CHECK(format.fileFilter() == "Test Format (*.gp3 *.gp4 *.gp5)");
 }
+
+TEST_CASE("Formats/FileFormat/ExportAtomic", "")
+{
+    namespace fs = boost::filesystem;
+
+    const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directory(dir);
+    const fs::path path = dir / "test.pt2";
+
+    SettingsManager settings_manager;
+    FileFormatManager manager(settings_manager);
+    const FileFormat format = *manager.findFormat("pt2");
+
+    Score score;
+    score.insertSystem(System());
+    score.insertPlayer(Player());
+
+    // Overwrite an existing file, with a few different compression levels.
+    for (int level : { 0, 1, 9 })
+    {
+        {
+            auto settings = settings_manager.getWriteHandle();
+            settings->set(Settings::PowerTabCompressionLevel, level);
+        }
+
+        manager.exportFile(score, path, format);
+
+        Score loaded;
+        manager.importFile(loaded, path, format);
+        REQUIRE(loaded == score);
+    }
+
+    // The permissions of the original file should be kept.
+    const fs::perms perms = fs::owner_read | fs::owner_write | fs::group_read;
+    fs::permissions(path, perms);
+    manager.exportFile(score, path, format);
+    REQUIRE((fs::status(path).permissions() & fs::all_all) == perms);
+
+#ifdef PTE_ENABLE_ZSTD
+    // Files can also be saved with zstd compression.
+    {
+        auto settings = settings_manager.getWriteHandle();
+        settings->set(Settings::PowerTabZstdCompression, true);
+    }
+
+    manager.exportFile(score, path, format);
+
+    Score loaded;
+    manager.importFile(loaded, path, format);
+    REQUIRE(loaded == score);
+#endif
+
+    // No temporary files should be left behind.
+    REQUIRE(std::distance(fs::directory_iterator(dir),
+                          fs::directory_iterator()) == 1);
+
+    // Errors, such as a missing directory, should be reported.
+    REQUIRE_THROWS(manager.exportFile(score, dir / "missing" / "test.pt2",
+                                      format));
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,176 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <boost/rational.hpp>
+#include <cstdlib>
+#include <midi/bendcurve.h>
+
+namespace
+{
+using Points = std::vector<BendCurve::Point>;
+
+/// The previous implementation of gradual bends, which used one event per
+/// pitch wheel step.
+Points generateReferenceBend(int start_tick, int duration, int start_bend,
+                             int release_bend)
+{
+    Points points;
+    const int num_events = std::abs(start_bend - release_bend);
+    if (!num_events)
+        return points;
+
+    const int event_duration = duration / num_events;
+    for (int i = 1; i <= num_events; ++i)
+    {
+        const int tick = start_tick + i * event_duration;
+        const int value =
+            start_bend < release_bend ? start_bend + i : start_bend - i;
+        points.push_back({ tick, static_cast<uint8_t>(value) });
+    }
+
+    return points;
+}
+
+/// Returns the pitch wheel value that is active at the tick.
+int getValueAt(const Points &points, int tick, int initial_value)
+{
+    int value = initial_value;
+    for (const BendCurve::Point &point : points)
+    {
+        if (point.myTick > tick)
+            break;
+
+        value = point.myValue;
+    }
+
+    return value;
+}
+
+/// Returns the largest difference between the two pitch contours.
+int getMaxDifference(const Points &a, const Points &b, int start_tick,
+                     int end_tick, int initial_value)
+{
+    int max_difference = 0;
+    for (int tick = start_tick; tick <= end_tick; ++tick)
+    {
+        max_difference =
+            std::max(max_difference,
+                     std::abs(getValueAt(a, tick, initial_value) -
+                              getValueAt(b, tick, initial_value)));
+    }
+
+    return max_difference;
+}
+}
+
+TEST_CASE("Midi/BendCurve/BendAmount", "")
+{
+    const boost::rational<int> quarter_tone(
+        127 - BendCurve::DEFAULT_BEND, 2 * BendCurve::PITCH_BEND_RANGE);
+
+    // The lookup table should match the previous calculation.
+    for (int i = -2 * BendCurve::PITCH_BEND_RANGE;
+         i <= 2 * BendCurve::PITCH_BEND_RANGE; ++i)
+    {
+        REQUIRE(BendCurve::getBendAmount(i) ==
+                boost::rational_cast<int>(BendCurve::DEFAULT_BEND +
+                                          i * quarter_tone));
+    }
+
+    REQUIRE(BendCurve::getBendAmount(0) == BendCurve::DEFAULT_BEND);
+    // Out of range bends are clamped.
+    REQUIRE(BendCurve::getBendAmount(1000) == 127);
+    REQUIRE(BendCurve::getBendAmount(-1000) == 1);
+}
+
+TEST_CASE("Midi/BendCurve/Ramp", "")
+{
+    SECTION("Full resolution")
+    {
+        BendCurve curve;
+        curve.addRamp(100, 480, 64, 74);
+
+        const Points expected = generateReferenceBend(100, 480, 64, 74);
+        REQUIRE(curve.getPoints().size() == expected.size());
+        REQUIRE(getMaxDifference(curve.getPoints(), expected, 100, 580, 64) <=
+                1);
+
+        // The end value is reached at the end of the duration.
+        REQUIRE(curve.getPoints().back().myTick == 580);
+        REQUIRE(curve.getPoints().back().myValue == 74);
+    }
+
+    SECTION("Downwards")
+    {
+        BendCurve curve;
+        curve.addRamp(0, 160, 64, 51);
+
+        const Points expected = generateReferenceBend(0, 160, 64, 51);
+        REQUIRE(getMaxDifference(curve.getPoints(), expected, 0, 160, 64) <=
+                1);
+        REQUIRE(curve.getPoints().back().myValue == 51);
+    }
+
+    SECTION("Limited resolution")
+    {
+        BendCurve::Resolution resolution;
+        resolution.myMinTicks = 30;
+        resolution.myMinStep = 2;
+
+        BendCurve curve(resolution);
+        // A fast slide over 12 frets.
+        curve.addRamp(0, 160, 64, BendCurve::getBendAmount(24));
+
+        const Points expected =
+            generateReferenceBend(0, 160, 64, BendCurve::getBendAmount(24));
+        REQUIRE(curve.getPoints().size() == 5);
+        REQUIRE(expected.size() == 31);
+
+        for (size_t i = 1; i < curve.getPoints().size(); ++i)
+        {
+            REQUIRE(curve.getPoints()[i].myTick -
+                        curve.getPoints()[i - 1].myTick >=
+                    30);
+        }
+
+        // The contour should stay close to the previous output.
+        REQUIRE(getMaxDifference(curve.getPoints(), expected, 0, 160, 64) <=
+                8);
+        REQUIRE(curve.getPoints().back().myValue ==
+                BendCurve::getBendAmount(24));
+    }
+
+    SECTION("Short duration")
+    {
+        BendCurve curve;
+        curve.addRamp(0, 2, 64, 74);
+
+        // Avoid generating multiple events at the same tick.
+        REQUIRE(curve.getPoints().size() == 2);
+        REQUIRE(curve.getPoints().back().myTick == 2);
+        REQUIRE(curve.getPoints().back().myValue == 74);
+    }
+
+    SECTION("No change")
+    {
+        BendCurve curve;
+        curve.addRamp(0, 480, 64, 64);
+        REQUIRE(curve.getPoints().empty());
+    }
+}
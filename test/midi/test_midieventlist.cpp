@@ -0,0 +1,53 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <midi/midieventlist.h>
+
+TEST_CASE("Midi/MidiEventList/RemoveRedundantPitchWheelEvents", "")
+{
+    MidiEventList events;
+    events.append(MidiEvent::pitchWheel(0, 1, 64));
+    events.append(MidiEvent::noteOn(0, 1, 60, 127, SystemLocation(0, 0)));
+    // Repeats the current value.
+    events.append(MidiEvent::pitchWheel(100, 1, 64));
+    // A different channel.
+    events.append(MidiEvent::pitchWheel(100, 2, 64));
+    events.append(MidiEvent::pitchWheel(200, 1, 70));
+    // Replaced by the next event at the same tick.
+    events.append(MidiEvent::pitchWheel(300, 1, 72));
+    events.append(MidiEvent::pitchWheel(300, 1, 64));
+    // Added out of order.
+    events.append(MidiEvent::pitchWheel(250, 1, 71));
+
+    events.removeRedundantPitchWheelEvents();
+
+    std::vector<std::pair<int, int>> remaining;
+    for (const MidiEvent &event : events)
+    {
+        if (event.isNoteOnOff())
+            continue;
+
+        remaining.emplace_back(event.getTicks(), event.getData()[2]);
+    }
+
+    const std::vector<std::pair<int, int>> expected = {
+        { 0, 64 }, { 100, 64 }, { 200, 70 }, { 250, 71 }, { 300, 64 }
+    };
+    REQUIRE(remaining == expected);
+}
@@ -0,0 +1,93 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <midi/midieventlist.h>
+#include <midi/midiloopbuffer.h>
+#include <midi/midiseekindex.h>
+#include <score/generalmidi.h>
+
+TEST_CASE("Midi/MidiLoopBuffer", "")
+{
+    MidiEventList events;
+    events.append(MidiEvent::noteOn(0, 1, 60, 127, SystemLocation(0, 1)));
+    events.append(MidiEvent::programChange(100, 1, 25));
+    events.append(MidiEvent::noteOn(200, 1, 62, 127, SystemLocation(0, 10)));
+    events.append(MidiEvent::setTempo(300, 400000));
+    events.append(MidiEvent::noteOn(400, 1, 64, 127, SystemLocation(0, 0)));
+    events.append(MidiEvent::noteOn(600, 1, 65, 127, SystemLocation(0, 20)));
+
+    std::vector<MidiFile::BarStart> bars = {
+        { 0, SystemLocation(0, 0), 10, 200 },
+        { 200, SystemLocation(0, 10), 20, 400 },
+        // Repeat the first bar.
+        { 400, SystemLocation(0, 0), 10, 600 },
+        { 600, SystemLocation(0, 20), 30, 800 }
+    };
+
+    MidiSeekIndex index(events, bars);
+
+    SECTION("Single bar")
+    {
+        auto loop = MidiLoopBuffer::create(events, index, SystemLocation(0, 12),
+                                           SystemLocation(0, 15));
+        REQUIRE(loop);
+        REQUIRE(loop->getStartLocation() == SystemLocation(0, 10));
+        REQUIRE(loop->getStartTick() == 200);
+        REQUIRE(loop->getLength() == 200);
+        REQUIRE(loop->getTempo() == Midi::BEAT_DURATION_120_BPM);
+
+        REQUIRE(loop->getEvents().size() == 2);
+        REQUIRE(loop->getEvents()[0].getTicks() == 0);
+        REQUIRE(loop->getEvents()[1].getTicks() == 100);
+        REQUIRE(loop->getEvents()[1].isTempoChange());
+
+        REQUIRE(loop->getRestoreEvents().size() == 1);
+        REQUIRE(loop->getRestoreEvents()[0].isProgramChange());
+    }
+
+    SECTION("Across a repeat")
+    {
+        // The end location is found after the start in playback order, so the
+        // repeated bar is included.
+        auto loop = MidiLoopBuffer::create(events, index, SystemLocation(0, 10),
+                                           SystemLocation(0, 5));
+        REQUIRE(loop);
+        REQUIRE(loop->getStartTick() == 200);
+        REQUIRE(loop->getEndTick() == 600);
+        REQUIRE(loop->getEvents().size() == 3);
+    }
+
+    SECTION("Last bar")
+    {
+        auto loop = MidiLoopBuffer::create(events, index, SystemLocation(0, 20),
+                                           SystemLocation(0, 25));
+        REQUIRE(loop);
+        // The loop ends at the end of the bar rather than at the last event.
+        REQUIRE(loop->getEndTick() == 800);
+        REQUIRE(loop->getLength() == 200);
+        REQUIRE(loop->getTempo() == 400000);
+        REQUIRE(loop->getEvents().size() == 1);
+    }
+
+    SECTION("Missing location")
+    {
+        REQUIRE(!MidiLoopBuffer::create(events, index, SystemLocation(0, 0),
+                                        SystemLocation(1, 0)));
+    }
+}
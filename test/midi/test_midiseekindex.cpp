@@ -0,0 +1,84 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <midi/midievent.h>
+#include <midi/midieventlist.h>
+#include <midi/midiseekindex.h>
+#include <score/generalmidi.h>
+
+TEST_CASE("Midi/MidiSeekIndex", "")
+{
+    MidiEventList events;
+    events.append(MidiEvent::programChange(0, 1, 25));
+    events.append(MidiEvent::volumeChange(0, 1, 100));
+    events.append(MidiEvent::noteOn(0, 1, 60, 127, SystemLocation(0, 1)));
+    events.append(MidiEvent::noteOff(100, 1, 60, SystemLocation(0, 1)));
+    events.append(MidiEvent::setTempo(100, 400000));
+    events.append(MidiEvent::holdPedal(150, 1, true));
+    events.append(MidiEvent::pitchWheel(150, 2, 80));
+    events.append(MidiEvent::volumeChange(200, 1, 50));
+
+    std::vector<MidiFile::BarStart> bars = {
+        { 0, SystemLocation(0, 0), 10, 200 },
+        { 200, SystemLocation(0, 10), 20, 400 },
+        // Repeat the first bar.
+        { 400, SystemLocation(0, 0), 10, 600 }
+    };
+
+    MidiSeekIndex index(events, bars);
+    REQUIRE(index.getEntries().size() == 3);
+
+    SECTION("Initial state")
+    {
+        const MidiSeekIndex::Entry *entry = index.find(SystemLocation(0, 5));
+        REQUIRE(entry == &index.getEntries()[0]);
+        REQUIRE(entry->myEventIndex == 0);
+        REQUIRE(entry->myTempo == Midi::BEAT_DURATION_120_BPM);
+        REQUIRE(!entry->myChannels[1].myProgram);
+        REQUIRE(MidiSeekIndex::getRestoreEvents(*entry).empty());
+    }
+
+    SECTION("Later bar")
+    {
+        const MidiSeekIndex::Entry *entry = index.find(SystemLocation(0, 15));
+        REQUIRE(entry == &index.getEntries()[1]);
+        REQUIRE(entry->myEventIndex == 7);
+        REQUIRE(entry->myTempo == 400000);
+
+        const MidiSeekIndex::ChannelState &channel = entry->myChannels[1];
+        REQUIRE(channel.myProgram == uint8_t(25));
+        // The volume change at the start of the bar is not included.
+        REQUIRE(channel.myVolume == uint8_t(100));
+        REQUIRE(channel.myHoldPedal == uint8_t(127));
+        REQUIRE(!channel.myPitchWheel);
+        REQUIRE(entry->myChannels[2].myPitchWheel == uint8_t(80));
+
+        // Program change, volume and hold pedal for channel 1, and the pitch
+        // wheel for channel 2.
+        auto restore_events = MidiSeekIndex::getRestoreEvents(*entry);
+        REQUIRE(restore_events.size() == 4);
+        REQUIRE(restore_events[0].isProgramChange());
+        REQUIRE(restore_events[3].getChannel() == 2);
+    }
+
+    SECTION("Missing location")
+    {
+        REQUIRE(index.find(SystemLocation(1, 0)) == nullptr);
+    }
+}
@@ -0,0 +1,79 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <midi/performancemap.h>
+#include <score/score.h>
+
+TEST_CASE("Midi/PerformanceMap", "")
+{
+    Score score;
+    System system;
+    system.insertBarline(Barline(5, Barline::RepeatEnd, 2));
+    score.insertSystem(system);
+    score.insertSystem(System());
+
+    PerformanceMap map;
+    map.update(score);
+
+    // The first bar is repeated, and each bar lasts 2 seconds.
+    const auto &bars = map.getBars();
+    REQUIRE(bars.size() == 4);
+    REQUIRE(map.getDuration() == 8000000);
+
+    REQUIRE(bars[0].myLocation == SystemLocation(0, 0));
+    REQUIRE(bars[0].myPass == 0);
+    REQUIRE(bars[1].myLocation == SystemLocation(0, 0));
+    REQUIRE(bars[1].myPass == 1);
+    REQUIRE(bars[1].myStartTime == 2000000);
+    REQUIRE(bars[2].myLocation == SystemLocation(0, 5));
+    REQUIRE(bars[3].myLocation == SystemLocation(1, 0));
+
+    SECTION("Find by location")
+    {
+        REQUIRE(map.findBar(SystemLocation(0, 3)) == &bars[0]);
+        REQUIRE(map.findBar(SystemLocation(0, 3), 1) == &bars[1]);
+        REQUIRE(map.findBar(SystemLocation(0, 3), 2) == nullptr);
+        REQUIRE(map.findBar(SystemLocation(0, 5)) == &bars[2]);
+        REQUIRE(map.findBar(SystemLocation(2, 0)) == nullptr);
+    }
+
+    SECTION("Find by time")
+    {
+        REQUIRE(map.findBarAtTime(0) == &bars[0]);
+        REQUIRE(map.findBarAtTime(3999999) == &bars[1]);
+        REQUIRE(map.findBarAtTime(5000000) == &bars[2]);
+        REQUIRE(map.findBarAtTime(8000000) == nullptr);
+    }
+
+    SECTION("Partial update")
+    {
+        TempoMarker marker(0);
+        marker.setBeatsPerMinute(60);
+        score.getSystems()[1].insertTempoMarker(marker);
+
+        // The cached timing is used until the system is marked as modified.
+        map.update(score);
+        REQUIRE(map.getDuration() == 8000000);
+
+        map.markSystemModified(1);
+        map.update(score);
+        REQUIRE(map.getDuration() == 10000000);
+        REQUIRE(map.getBars()[3].myBeatDuration == 1000000);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <score/score.h>
+#include <score/utils/barindex.h>
+
+static System makeSystem(const std::vector<int> &barPositions)
+{
+    System system;
+    for (int position : barPositions)
+        system.insertBarline(Barline(position, Barline::SingleBar));
+    return system;
+}
+
+TEST_CASE("Score/BarIndex/Lookups", "")
+{
+    Score score;
+    score.insertSystem(makeSystem({ 10, 20 }));
+    score.insertSystem(makeSystem({}));
+    score.insertSystem(makeSystem({ 5 }));
+
+    BarIndex index(score);
+    REQUIRE(index.getBarCount() == 6);
+    REQUIRE(index.getFirstBar(0) == 0);
+    REQUIRE(index.getFirstBar(1) == 3);
+    REQUIRE(index.getFirstBar(2) == 4);
+
+    BarIndex::Bar bar = index.getBar(1);
+    REQUIRE(bar.mySystem == 0);
+    REQUIRE(bar.myBarline == 1);
+    REQUIRE(bar.myStartPosition == 10);
+    REQUIRE(bar.myEndPosition == 20);
+
+    bar = index.getBar(3);
+    REQUIRE(bar.mySystem == 1);
+    REQUIRE(bar.myBarline == 0);
+
+    bar = index.getBar(5);
+    REQUIRE(bar.mySystem == 2);
+    REQUIRE(bar.myStartPosition == 5);
+
+    REQUIRE_THROWS(index.getBar(6));
+
+    REQUIRE(index.findBar(0, 0) == 0);
+    REQUIRE(index.findBar(0, 9) == 0);
+    REQUIRE(index.findBar(0, 10) == 1);
+    REQUIRE(index.findBar(0, 25) == 2);
+    REQUIRE(index.findBar(1, 3) == 3);
+    REQUIRE(index.findBar(2, 4) == 4);
+    REQUIRE(index.findBar(2, 100) == 5);
+}
+
+TEST_CASE("Score/BarIndex/Invalidate", "")
+{
+    Score score;
+    score.insertSystem(makeSystem({}));
+    score.insertSystem(makeSystem({}));
+    score.insertSystem(makeSystem({}));
+
+    BarIndex index(score);
+    REQUIRE(index.getFirstBar(2) == 2);
+
+    // Adding a barline should shift the following systems.
+    score.getSystems()[0].insertBarline(Barline(5, Barline::SingleBar));
+    index.invalidate(0);
+    REQUIRE(index.getFirstBar(2) == 3);
+    REQUIRE(index.getBarCount() == 4);
+
+    // Insert and remove systems.
+    score.insertSystem(makeSystem({ 1, 2 }), 1);
+    index.invalidate(1);
+    REQUIRE(index.getFirstBar(2) == 5);
+    REQUIRE(index.getBarCount() == 7);
+
+    score.removeSystem(0);
+    index.invalidate(0);
+    REQUIRE(index.getFirstBar(1) == 3);
+    REQUIRE(index.getBarCount() == 5);
+
+    score.removeSystem(2);
+    index.invalidate(2);
+    REQUIRE(index.getBarCount() == 4);
+}
+
+TEST_CASE("Score/BarIndex/Duration", "")
+{
+    Score score;
+    System system;
+    TimeSignature timeSig;
+    timeSig.setBeatsPerMeasure(6);
+    timeSig.setBeatValue(8);
+    Barline bar(4, Barline::SingleBar);
+    bar.setTimeSignature(timeSig);
+    system.insertBarline(bar);
+    score.insertSystem(system);
+
+    BarIndex index(score);
+    REQUIRE(index.getDuration(0) == 4);
+    REQUIRE(index.getDuration(1) == 3);
+}
@@ -164,3 +164,27 @@ TEST_CASE("Score/Note/Serialization", "")
 
     Serialization::test("note", note);
 }
+
+TEST_CASE("Score/Note/Copy", "")
+{
+    Note note(2, 7);
+    note.setTrilledFret(9);
+    note.setBend(Bend(Bend::PreBend, 4));
+
+    // Copies should not share the less common properties with the original.
+    Note copy(note);
+    REQUIRE(copy == note);
+    copy.clearTrill();
+    REQUIRE(note.hasTrill());
+    REQUIRE(!copy.hasTrill());
+
+    copy = note;
+    REQUIRE(copy == note);
+    copy.setBend(Bend(Bend::GradualRelease, 2));
+    REQUIRE(note.getBend().getType() == Bend::PreBend);
+
+    // Clearing every property should give a note equal to a plain note.
+    copy.clearTrill();
+    copy.clearBend();
+    REQUIRE(copy == Note(2, 7));
+}
@@ -17,7 +17,9 @@
   
 #include <catch2/catch.hpp>
 
+#include <score/binaryserialization.h>
 #include <score/playerchange.h>
+#include <sstream>
 #include "test_serialization.h"
 
 TEST_CASE("Score/PlayerChange/ActivePlayers", "")
@@ -43,3 +45,21 @@ TEST_CASE("Score/PlayerChange/Serialization", "")
 
     Serialization::test("player_change", change);
 }
+
+TEST_CASE("Score/PlayerChange/BinaryOverwrite", "")
+{
+    PlayerChange change;
+    change.insertActivePlayer(1, ActivePlayer(3, 2));
+
+    std::ostringstream output;
+    ScoreUtils::saveBinary(output, "player_change", change);
+
+    // Loading into an existing object should replace its active players, not
+    // merge with them.
+    PlayerChange copy;
+    copy.insertActivePlayer(0, ActivePlayer(1, 1));
+    std::istringstream input(output.str());
+    ScoreUtils::loadBinary(input, "player_change", copy);
+
+    REQUIRE(copy == change);
+}
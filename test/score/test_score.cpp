@@ -17,8 +17,39 @@
   
 #include <catch2/catch.hpp>
 
+#include <memory_resource>
 #include <score/score.h>
 
+namespace
+{
+/// Counts the allocations that are made through it.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int myAllocations = 0;
+    int myOutstanding = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++myAllocations;
+        ++myOutstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        --myOutstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+}
+
 TEST_CASE("Score/Score/Systems", "")
 {
     Score score;
@@ -77,3 +108,48 @@ TEST_CASE("Score/Score/ViewFilters", "")
     REQUIRE(score.getViewFilters().size() == 1);
     REQUIRE(score.getViewFilters()[0] == filter1);
 }
+
+TEST_CASE("Score/Score/Clone", "")
+{
+    Score score;
+    score.insertSystem(System());
+    score.insertPlayer(Player());
+    score.setLineSpacing(12);
+
+    std::unique_ptr<Score> copy = score.clone();
+    REQUIRE(*copy == score);
+
+    // The copy should be independent of the original.
+    score.removeSystem(0);
+    REQUIRE(copy->getSystems().size() == 1);
+}
+
+TEST_CASE("Score/Score/MemoryResource", "")
+{
+    CountingResource resource;
+    Score score(&resource);
+
+    Staff staff;
+    Position pos(3);
+    pos.insertNote(Note(1, 5));
+    staff.getVoices()[0].insertPosition(pos);
+    System system;
+    system.insertStaff(staff);
+
+    // Inserting the system should copy the staves, positions, etc. into the
+    // score's memory.
+    score.insertSystem(system);
+    REQUIRE(resource.myAllocations > 0);
+    REQUIRE(score.getSystems()[0] == system);
+
+    // Copies are independent of the score's memory.
+    const int allocations = resource.myAllocations;
+    std::unique_ptr<Score> copy = score.clone();
+    REQUIRE(resource.myAllocations == allocations);
+    REQUIRE(*copy == score);
+
+    score.insertSystem(system);
+    score.clearSystems();
+    REQUIRE(score.getSystems().empty());
+    REQUIRE(resource.myOutstanding == 0);
+}
@@ -0,0 +1,62 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <score/score.h>
+#include <score/utils/scorepolisher.h>
+
+static void makeScore(Score &score, int num_systems)
+{
+    for (int i = 0; i < num_systems; ++i)
+    {
+        System system;
+        Staff staff(6);
+        Voice &voice = staff.getVoices()[0];
+
+        // Use a different (and uneven) spacing for each system.
+        const int spacing = 1 + i % 3;
+        voice.insertPosition(Position(0, Position::QuarterNote));
+        voice.insertPosition(Position(spacing, Position::EighthNote));
+        voice.insertPosition(Position(2 * spacing, Position::HalfNote));
+        voice.insertPosition(Position(8 * spacing, Position::WholeNote));
+
+        system.insertStaff(staff);
+        system.insertBarline(Barline(7 * spacing, Barline::SingleBar));
+        system.getBarlines().back().setPosition(20 * spacing);
+        score.insertSystem(system);
+    }
+}
+
+TEST_CASE("Score/ScorePolisher/Threads", "")
+{
+    Score original, serial, parallel;
+    makeScore(original, 50);
+    makeScore(serial, 50);
+    makeScore(parallel, 50);
+
+    ScoreUtils::polishScore(serial, 1);
+    ScoreUtils::polishScore(parallel, 8);
+
+    REQUIRE(!(serial == original));
+    REQUIRE(serial == parallel);
+
+    const Voice &voice = parallel.getSystems()[1].getStaves()[0].getVoices()[0];
+    REQUIRE(voice.getPositions()[0].getPosition() == 0);
+    REQUIRE(voice.getPositions()[1].getPosition() == 2);
+    REQUIRE(voice.getPositions()[2].getPosition() == 3);
+}
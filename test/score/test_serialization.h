@@ -20,6 +20,7 @@
 
 #include <catch2/catch.hpp>
 
+#include <score/binaryserialization.h>
 #include <score/serialization.h>
 #include <sstream>
 
@@ -30,12 +31,25 @@ namespace Serialization {
     template <typename T>
     void test(const char *name, const T &original)
     {
+        for (auto format : { ScoreUtils::OutputFormat::Pretty,
+                             ScoreUtils::OutputFormat::Compact })
+        {
+            std::ostringstream output;
+            ScoreUtils::save(output, name, original, format);
+
+            T copy;
+            std::istringstream input(output.str());
+            ScoreUtils::load(input, name, copy);
+
+            REQUIRE(original == copy);
+        }
+
         std::ostringstream output;
-        ScoreUtils::save(output, name, original);
+        ScoreUtils::saveBinary(output, name, original);
 
         T copy;
         std::istringstream input(output.str());
-        ScoreUtils::load(input, name, copy);
+        ScoreUtils::loadBinary(input, name, copy);
 
         REQUIRE(original == copy);
     }
@@ -0,0 +1,76 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <catch2/catch.hpp>
+
+#include <score/utils/voicetiming.h>
+#include <score/voice.h>
+#include <score/voiceutils.h>
+
+TEST_CASE("Score/VoiceTiming", "")
+{
+    Voice voice;
+
+    Position quarter(0, Position::QuarterNote);
+    voice.insertPosition(quarter);
+
+    // Eighth note triplet.
+    for (int i = 1; i <= 3; ++i)
+        voice.insertPosition(Position(i, Position::EighthNote));
+    voice.insertIrregularGrouping(IrregularGrouping(1, 3, 3, 2));
+
+    Position grace(4, Position::EighthNote);
+    grace.setProperty(Position::Acciaccatura);
+    voice.insertPosition(grace);
+
+    Position dotted(5, Position::SixtyFourthNote);
+    dotted.setProperty(Position::DoubleDotted);
+    voice.insertPosition(dotted);
+
+    voice.insertPosition(Position(6, Position::HalfNote));
+
+    VoiceTiming timing(voice);
+    const int64_t quarterTicks = VoiceTiming::TICKS_PER_QUARTER;
+
+    auto positions = voice.getPositions();
+    REQUIRE(timing.getStartTime(positions[0]) == 0);
+    REQUIRE(timing.getDuration(positions[0]) == quarterTicks);
+    REQUIRE(timing.getDuration(positions[1]) == quarterTicks / 3);
+    REQUIRE(timing.getStartTime(positions[4]) == 2 * quarterTicks);
+    REQUIRE(timing.getDuration(positions[4]) == 0);
+    REQUIRE(timing.getDuration(positions[5]) == quarterTicks * 7 / 64);
+    REQUIRE(timing.getStartTime(positions[6]) ==
+            timing.getStartTime(positions[5]) + quarterTicks * 7 / 64);
+    REQUIRE(timing.getEndTime() ==
+            timing.getStartTime(positions[6]) + 2 * quarterTicks);
+
+    // The durations should match the rational durations.
+    for (const Position &pos : positions)
+    {
+        REQUIRE(VoiceTiming::toQuarterNotes(timing.getDuration(pos)) ==
+                Approx(boost::rational_cast<double>(
+                    VoiceUtils::getDurationTime(voice, pos))));
+    }
+}
+
+TEST_CASE("Score/VoiceTiming/Empty", "")
+{
+    Voice voice;
+    VoiceTiming timing(voice);
+    REQUIRE(timing.getEndTime() == 0);
+}
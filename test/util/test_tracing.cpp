@@ -0,0 +1,124 @@
+/*
+  * Copyright (C) 2020 Cameron White
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <rapidjson/document.h>
+#include <sstream>
+#include <util/tracing.h>
+
+static rapidjson::Document exportTrace()
+{
+    std::ostringstream os;
+    Tracing::writeChromeTrace(os);
+
+    rapidjson::Document doc;
+    doc.Parse(os.str().c_str());
+    REQUIRE(!doc.HasParseError());
+    return doc;
+}
+
+TEST_CASE("Util/Tracing/Disabled")
+{
+    Tracing::enable();
+    Tracing::disable();
+
+    {
+        Tracing::Span span("Disabled span");
+        REQUIRE(!span.isActive());
+    }
+
+    rapidjson::Document doc = exportTrace();
+    const rapidjson::Value &events = doc["traceEvents"];
+    REQUIRE(events.IsArray());
+    for (auto it = events.Begin(); it != events.End(); ++it)
+        REQUIRE(std::string((*it)["ph"].GetString()) != "X");
+}
+
+TEST_CASE("Util/Tracing/Spans")
+{
+    Tracing::enable();
+    Tracing::setThreadName("Test");
+
+    {
+        Tracing::Span outer("Outer");
+        REQUIRE(outer.isActive());
+        outer.setDetail("file.pt2");
+
+        Tracing::Span inner("Inner");
+    }
+
+    Tracing::disable();
+
+    rapidjson::Document doc = exportTrace();
+    int num_spans = 0;
+    bool found_thread_name = false;
+
+    const rapidjson::Value &events = doc["traceEvents"];
+    for (auto it = events.Begin(); it != events.End(); ++it)
+    {
+        const rapidjson::Value &event = *it;
+        const std::string phase = event["ph"].GetString();
+        const std::string name = event["name"].GetString();
+
+        if (phase == "M")
+        {
+            if (name == "thread_name" &&
+                std::string(event["args"]["name"].GetString()) == "Test")
+            {
+                found_thread_name = true;
+            }
+            continue;
+        }
+
+        REQUIRE(phase == "X");
+        REQUIRE(event["dur"].GetDouble() >= 0);
+        ++num_spans;
+
+        if (name == "Outer")
+            REQUIRE(std::string(event["args"]["detail"].GetString()) ==
+                    "file.pt2");
+        else
+        {
+            REQUIRE(name == "Inner");
+            REQUIRE(!event.HasMember("args"));
+        }
+    }
+
+    REQUIRE(num_spans == 2);
+    REQUIRE(found_thread_name);
+}
+
+TEST_CASE("Util/Tracing/Capacity")
+{
+    // Only the most recent spans are kept.
+    Tracing::enable(3);
+    for (const char *name : { "A", "B", "C", "D", "E" })
+        Tracing::Span span(name);
+    Tracing::disable();
+
+    rapidjson::Document doc = exportTrace();
+    std::string names;
+    const rapidjson::Value &events = doc["traceEvents"];
+    for (auto it = events.Begin(); it != events.End(); ++it)
+    {
+        if (std::string((*it)["ph"].GetString()) == "X")
+            names += (*it)["name"].GetString();
+    }
+
+    REQUIRE(names == "CDE");
+}